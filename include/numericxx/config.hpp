@@ -15,4 +15,83 @@
 #include "types.hpp"
 #include "version.hpp"
 
+/*
+ * BigInt multiplication thresholds, in limbs of the smaller operand. Each
+ * algorithm is used from its threshold up to the next one, and they can be
+ * tuned for the target machine by defining them at build time.
+ */
+
+// Smallest operands multiplied with Karatsuba instead of schoolbook
+#ifndef NUMERICXX_BIGINT_KARATSUBA_THRESHOLD
+#define NUMERICXX_BIGINT_KARATSUBA_THRESHOLD 32
+#endif
+
+// Smallest operands multiplied with Toom-3 instead of Karatsuba
+#ifndef NUMERICXX_BIGINT_TOOM3_THRESHOLD
+#define NUMERICXX_BIGINT_TOOM3_THRESHOLD 256
+#endif
+
+// Smallest operands multiplied with Toom-4 instead of Toom-3
+#ifndef NUMERICXX_BIGINT_TOOM4_THRESHOLD
+#define NUMERICXX_BIGINT_TOOM4_THRESHOLD 384
+#endif
+
+// Smallest operands multiplied with a three-prime NTT instead of Toom-4
+#ifndef NUMERICXX_BIGINT_NTT_THRESHOLD
+#define NUMERICXX_BIGINT_NTT_THRESHOLD 16384
+#endif
+
+// Karatsuba splits its operands in two and Toom-3 in three, which cannot
+// make a one-limb operand (or a two-limb one, for Toom-3) any smaller
+static_assert(NUMERICXX_BIGINT_KARATSUBA_THRESHOLD >= 2,
+              "NUMERICXX_BIGINT_KARATSUBA_THRESHOLD must be at least 2");
+static_assert(NUMERICXX_BIGINT_TOOM3_THRESHOLD >= 3,
+              "NUMERICXX_BIGINT_TOOM3_THRESHOLD must be at least 3");
+static_assert(NUMERICXX_BIGINT_KARATSUBA_THRESHOLD <=
+                      NUMERICXX_BIGINT_TOOM3_THRESHOLD &&
+                  NUMERICXX_BIGINT_TOOM3_THRESHOLD <=
+                      NUMERICXX_BIGINT_TOOM4_THRESHOLD &&
+                  NUMERICXX_BIGINT_TOOM4_THRESHOLD <=
+                      NUMERICXX_BIGINT_NTT_THRESHOLD,
+              "BigInt multiplication thresholds must not decrease");
+
+/*
+ * BigInt division thresholds, in limbs of the smaller of the divisor and the
+ * quotient.
+ */
+
+// Smallest operands divided with Burnikel-Ziegler instead of Knuth's algorithm
+#ifndef NUMERICXX_BIGINT_BZ_THRESHOLD
+#define NUMERICXX_BIGINT_BZ_THRESHOLD 64
+#endif
+
+// Smallest operands divided by a Newton reciprocal instead of Burnikel-Ziegler
+#ifndef NUMERICXX_BIGINT_NEWTON_DIV_THRESHOLD
+#define NUMERICXX_BIGINT_NEWTON_DIV_THRESHOLD 32768
+#endif
+
+// Burnikel-Ziegler halves the divisor down to below its threshold, which a
+// threshold of 1 never reaches
+static_assert(NUMERICXX_BIGINT_BZ_THRESHOLD >= 2,
+              "NUMERICXX_BIGINT_BZ_THRESHOLD must be at least 2");
+static_assert(NUMERICXX_BIGINT_BZ_THRESHOLD <=
+                  NUMERICXX_BIGINT_NEWTON_DIV_THRESHOLD,
+              "BigInt division thresholds must not decrease");
+
+// Smallest moduli, in limbs, whose Montgomery reduction multiplies by the
+// inverse of the whole modulus instead of clearing a limb at a time
+#ifndef NUMERICXX_BIGINT_REDC_THRESHOLD
+#define NUMERICXX_BIGINT_REDC_THRESHOLD 256
+#endif
+
+// Smallest numbers, in limbs, converted to and from digit strings by
+// splitting them in half instead of a chunk of digits at a time
+#ifndef NUMERICXX_BIGINT_RADIX_THRESHOLD
+#define NUMERICXX_BIGINT_RADIX_THRESHOLD 32
+#endif
+
+// a single limb cannot be split, and digits_to_limbs needs two chunks
+static_assert(NUMERICXX_BIGINT_RADIX_THRESHOLD >= 2,
+              "NUMERICXX_BIGINT_RADIX_THRESHOLD must be at least 2");
+
 #endif // config.hpp
\ No newline at end of file
@@ -0,0 +1,178 @@
+/**
+ * @file modint.hpp
+ * @author Jaeseok Lee
+ * @brief Integers modulo a compile-time prime
+ * @version 0.1.0
+ * @date 2025-03-14
+ *
+ * @copyright MIT License (c) 2025
+ *
+ */
+
+#ifndef NUMERICXX_MODINT_HPP_
+#define NUMERICXX_MODINT_HPP_
+
+#include <concepts>
+#include <type_traits>
+
+#include "montgomery.hpp"
+#include "types.hpp"
+
+namespace numericxx {
+
+/*
+ * ModInt<P> is an integer modulo the odd prime P, which is a template argument
+ * so that every reduction constant is computed at compile time and the
+ * compiler can specialise the arithmetic for it. Moduli up to 2^32 are held in
+ * a u32 and multiplied through u64, larger ones in a u64 through u128.
+ *
+ * Values are stored in Montgomery form with R = 2^32 or 2^64, so that
+ * multiplication needs no division. ModInt is trivially copyable, has the size
+ * of its value type, and all of its operations are constexpr:
+ *
+ *     using mint = numericxx::ModInt<998244353>;
+ *     constexpr mint root = mint::primitive_root();
+ *     static_assert((mint(2) / 3 * 3).value() == 2);
+ *
+ * Division and `inverse` rely on P being prime.
+ */
+template <u64 P> class ModInt {
+  static_assert(P % 2 == 1 && P > 1, "ModInt modulus must be an odd prime");
+
+public:
+  using value_type = std::conditional_t<(P <= U32_MAX), u32, u64>;
+
+private:
+  using wide_type = std::conditional_t<(P <= U32_MAX), u64, u128>;
+
+  static constexpr int BITS = 8 * sizeof(value_type);
+  static constexpr value_type MOD = P;
+  // P^-1 mod R, truncated from the inverse modulo 2^64
+  static constexpr value_type INVERSE =
+      (value_type)detail::inverse_mod_word((u64)P);
+  // R^2 mod P
+  static constexpr value_type R_SQUARED =
+      (value_type)((~(wide_type)0 % MOD + 1) % MOD);
+
+  value_type montgomery; // value * R mod P
+
+  // num * R^-1 mod P, for any num < P * R
+  static constexpr value_type reduce(wide_type num) {
+    value_type q = (value_type)num * INVERSE;
+    value_type high = (value_type)(num >> BITS);
+    value_type subtrahend = (value_type)(((wide_type)q * MOD) >> BITS);
+    return high >= subtrahend ? high - subtrahend : high - subtrahend + MOD;
+  }
+
+public:
+  constexpr ModInt() : montgomery(0) {}
+
+  // Residue of any integer, including negative ones
+  template <std::integral Integer>
+  constexpr ModInt(Integer num) : montgomery(0) {
+    value_type residue;
+    if constexpr (std::is_signed_v<Integer>) {
+      // -(num + 1) cannot overflow, unlike -num
+      if (num < 0)
+        residue = MOD - 1 - (value_type)((u64)(-(num + 1)) % MOD);
+      else
+        residue = (value_type)((u64)num % MOD);
+    } else {
+      residue = (value_type)((u64)num % MOD);
+    }
+    montgomery = reduce((wide_type)residue * R_SQUARED);
+  }
+
+  static constexpr value_type modulus() { return MOD; }
+
+  // Residue in [0, P)
+  constexpr value_type value() const { return reduce(montgomery); }
+
+  constexpr ModInt& operator+=(const ModInt& other) {
+    value_type sum = montgomery + other.montgomery;
+    montgomery = sum < montgomery || sum >= MOD ? sum - MOD : sum;
+    return *this;
+  }
+
+  constexpr ModInt& operator-=(const ModInt& other) {
+    montgomery = montgomery >= other.montgomery
+                     ? montgomery - other.montgomery
+                     : montgomery - other.montgomery + MOD;
+    return *this;
+  }
+
+  constexpr ModInt& operator*=(const ModInt& other) {
+    montgomery = reduce((wide_type)montgomery * other.montgomery);
+    return *this;
+  }
+
+  constexpr ModInt& operator/=(const ModInt& other) {
+    return *this *= other.inverse();
+  }
+
+  friend constexpr ModInt operator+(ModInt num1, const ModInt& num2) {
+    return num1 += num2;
+  }
+  friend constexpr ModInt operator-(ModInt num1, const ModInt& num2) {
+    return num1 -= num2;
+  }
+  friend constexpr ModInt operator*(ModInt num1, const ModInt& num2) {
+    return num1 *= num2;
+  }
+  friend constexpr ModInt operator/(ModInt num1, const ModInt& num2) {
+    return num1 /= num2;
+  }
+
+  constexpr ModInt operator+() const { return *this; }
+  constexpr ModInt operator-() const { return ModInt() - *this; }
+
+  // Montgomery forms are fully reduced, so they compare like the values
+  friend constexpr bool operator==(const ModInt&, const ModInt&) = default;
+
+  constexpr ModInt pow(u64 exp) const {
+    ModInt result = 1, base = *this;
+    for (; exp; exp >>= 1) {
+      if (exp & 1)
+        result *= base;
+      base *= base;
+    }
+    return result;
+  }
+
+  // Multiplicative inverse by Fermat's little theorem; that of 0 is 0
+  constexpr ModInt inverse() const { return pow(P - 2); }
+
+  /*
+   * Smallest generator of the multiplicative group modulo P, found by
+   * factoring P - 1 with trial division. This is cheap for the usual NTT and
+   * hashing primes, whose P - 1 has only small factors beside at most one
+   * large one, but not for every 64-bit prime, so it is evaluated only when
+   * called.
+   */
+  static constexpr value_type primitive_root() {
+    u64 factors[64] = {};
+    int num_factors = 0;
+    u64 rest = P - 1;
+    for (u64 divisor = 2; divisor <= rest / divisor; divisor++) {
+      if (rest % divisor == 0) {
+        factors[num_factors++] = divisor;
+        while (rest % divisor == 0)
+          rest /= divisor;
+      }
+    }
+    if (rest > 1)
+      factors[num_factors++] = rest;
+
+    for (value_type root = 2;; root++) {
+      bool is_generator = true;
+      for (int i = 0; i < num_factors && is_generator; i++)
+        is_generator = ModInt(root).pow((P - 1) / factors[i]) != ModInt(1);
+      if (is_generator)
+        return root;
+    }
+  }
+};
+
+} // namespace numericxx
+
+#endif // modint.hpp
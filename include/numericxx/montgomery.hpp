@@ -0,0 +1,202 @@
+/**
+ * @file montgomery.hpp
+ * @author Jaeseok Lee
+ * @brief Montgomery modular arithmetic for a fixed odd modulus
+ * @version 0.1.0
+ * @date 2025-03-14
+ *
+ * @copyright MIT License (c) 2025
+ *
+ */
+
+#ifndef NUMERICXX_MONTGOMERY_HPP_
+#define NUMERICXX_MONTGOMERY_HPP_
+
+#include <stdexcept>
+
+#include "types.hpp"
+
+namespace numericxx {
+
+/*
+ * MontgomeryContext<T> holds the constants for arithmetic modulo an odd
+ * modulus of type T, which is fixed at runtime. Values are kept in Montgomery
+ * form a * R mod m, where R is 2 to the number of bits of the modulus type,
+ * so that a product is reduced with multiplications and shifts instead of a
+ * division. Convert operands in with `to_montgomery` once, chain `mul`, `add`
+ * and `sub` on them, and convert the result out with `from_montgomery`.
+ *
+ * The context is specialised for u64 and u128 here, and for BigInt in
+ * BigInt.hpp.
+ */
+template <class T> class MontgomeryContext;
+
+namespace detail {
+
+// Inverse of the odd `num` modulo 2^64 (or 2^128), by Newton's iteration,
+// which doubles the number of correct low bits starting from the 3 bits of
+// num * num == 1 (mod 8)
+constexpr u64 inverse_mod_word(u64 num) {
+  u64 inverse = num;
+  for (int i = 0; i < 5; i++)
+    inverse *= 2 - num * inverse;
+  return inverse;
+}
+
+constexpr u128 inverse_mod_word(u128 num) {
+  u128 inverse = num;
+  for (int i = 0; i < 6; i++)
+    inverse *= 2 - num * inverse;
+  return inverse;
+}
+
+// High 128 bits of the 256-bit product of two 128-bit numbers
+constexpr u128 mul_high(u128 num1, u128 num2) {
+  u128 low1 = (u64)num1, high1 = num1 >> 64;
+  u128 low2 = (u64)num2, high2 = num2 >> 64;
+  u128 low_low = low1 * low2, low_high = low1 * high2;
+  u128 high_low = high1 * low2, high_high = high1 * high2;
+  u128 middle = (low_low >> 64) + (u64)low_high + (u64)high_low;
+  return high_high + (low_high >> 64) + (high_low >> 64) + (middle >> 64);
+}
+
+template <class T> constexpr T check_montgomery_modulus(T modulus) {
+  if (modulus % 2 == 0)
+    throw std::invalid_argument("Montgomery modulus must be odd");
+  return modulus;
+}
+
+} // namespace detail
+
+/*
+ * Montgomery arithmetic modulo an odd 64-bit modulus, with R = 2^64. Every
+ * operation except `to_montgomery` expects operands below the modulus and
+ * returns a value below it.
+ */
+template <> class MontgomeryContext<u64> {
+  u64 mod;
+  u64 inverse;   // mod^-1 mod 2^64
+  u64 r_squared; // R^2 mod mod
+
+public:
+  using value_type = u64;
+
+  // Throws std::invalid_argument if the modulus is even
+  constexpr explicit MontgomeryContext(u64 modulus)
+      : mod(detail::check_montgomery_modulus(modulus)),
+        inverse(detail::inverse_mod_word(modulus)),
+        r_squared((u64)(~(u128)0 % modulus + 1) % modulus) {}
+
+  constexpr u64 modulus() const { return mod; }
+
+  // Montgomery form of 1, that is R mod m
+  constexpr u64 one() const { return (0 - mod) % mod; }
+
+  // num * R^-1 mod m, for any num < m * 2^64
+  constexpr u64 reduce(u128 num) const {
+    // num - q * mod is divisible by 2^64, so only the high halves differ
+    u64 q = (u64)num * inverse;
+    u64 high = (u64)(num >> 64), subtrahend = (u64)(((u128)q * mod) >> 64);
+    return high >= subtrahend ? high - subtrahend : high - subtrahend + mod;
+  }
+
+  // Montgomery form of any 64-bit value, which need not be below the modulus
+  constexpr u64 to_montgomery(u64 num) const {
+    return reduce((u128)num * r_squared);
+  }
+
+  constexpr u64 from_montgomery(u64 num) const { return reduce(num); }
+
+  constexpr u64 mul(u64 num1, u64 num2) const {
+    return reduce((u128)num1 * num2);
+  }
+
+  constexpr u64 add(u64 num1, u64 num2) const {
+    u64 sum = num1 + num2;
+    return sum < num1 || sum >= mod ? sum - mod : sum;
+  }
+
+  constexpr u64 sub(u64 num1, u64 num2) const {
+    return num1 >= num2 ? num1 - num2 : num1 - num2 + mod;
+  }
+
+  // base^exp, for a base in Montgomery form and with the result in it
+  constexpr u64 pow(u64 base, u64 exp) const {
+    u64 result = one();
+    for (; exp; exp >>= 1) {
+      if (exp & 1)
+        result = mul(result, base);
+      base = mul(base, base);
+    }
+    return result;
+  }
+};
+
+/*
+ * Montgomery arithmetic modulo an odd 128-bit modulus, with R = 2^128, on
+ * 256-bit products held as pairs of 128-bit halves.
+ */
+template <> class MontgomeryContext<u128> {
+  u128 mod;
+  u128 inverse;   // mod^-1 mod 2^128
+  u128 r_squared; // R^2 mod mod
+
+public:
+  using value_type = u128;
+
+  // Throws std::invalid_argument if the modulus is even
+  constexpr explicit MontgomeryContext(u128 modulus)
+      : mod(detail::check_montgomery_modulus(modulus)),
+        inverse(detail::inverse_mod_word(modulus)), r_squared(one()) {
+    // R^2 mod m by doubling R mod m another 128 times
+    for (int i = 0; i < 128; i++)
+      r_squared = add(r_squared, r_squared);
+  }
+
+  constexpr u128 modulus() const { return mod; }
+
+  // Montgomery form of 1, that is R mod m
+  constexpr u128 one() const { return (0 - mod) % mod; }
+
+  // (high * 2^128 + low) * R^-1 mod m, for any such number below m * 2^128
+  constexpr u128 reduce(u128 high, u128 low) const {
+    u128 q = low * inverse;
+    u128 subtrahend = detail::mul_high(q, mod);
+    return high >= subtrahend ? high - subtrahend : high - subtrahend + mod;
+  }
+
+  // Montgomery form of any 128-bit value, which need not be below the modulus
+  constexpr u128 to_montgomery(u128 num) const {
+    return reduce(detail::mul_high(num, r_squared), num * r_squared);
+  }
+
+  constexpr u128 from_montgomery(u128 num) const { return reduce(0, num); }
+
+  constexpr u128 mul(u128 num1, u128 num2) const {
+    return reduce(detail::mul_high(num1, num2), num1 * num2);
+  }
+
+  constexpr u128 add(u128 num1, u128 num2) const {
+    u128 sum = num1 + num2;
+    return sum < num1 || sum >= mod ? sum - mod : sum;
+  }
+
+  constexpr u128 sub(u128 num1, u128 num2) const {
+    return num1 >= num2 ? num1 - num2 : num1 - num2 + mod;
+  }
+
+  // base^exp, for a base in Montgomery form and with the result in it
+  constexpr u128 pow(u128 base, u128 exp) const {
+    u128 result = one();
+    for (; exp; exp >>= 1) {
+      if (exp & 1)
+        result = mul(result, base);
+      base = mul(base, base);
+    }
+    return result;
+  }
+};
+
+} // namespace numericxx
+
+#endif // montgomery.hpp
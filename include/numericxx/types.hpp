@@ -48,6 +48,13 @@ typedef __uint64_t u64;
 typedef __int128_t i128;
 typedef __uint128_t u128;
 
+// Maximum value 128-bit integer can hold
+constexpr i128 I128_MAX = (i128)(~(u128)0 >> 1);
+// Minimum value 128-bit integer can hold
+constexpr i128 I128_MIN = -I128_MAX - 1;
+// Maximum value 128-bit unsigned integer can hold
+constexpr u128 U128_MAX = ~(u128)0;
+
 #endif
 #endif
 
@@ -10,6 +10,300 @@
     License: MIT
 */
 
+/*
+    ===========================================================================
+    Limb storage
+    ===========================================================================
+    Small-buffer vector holding the magnitude of a BigInt.
+*/
+
+#ifndef BIG_INT_LIMB_VECTOR_HPP
+#define BIG_INT_LIMB_VECTOR_HPP
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+#include "numericxx/types.hpp"
+
+namespace numericxx {
+
+/*
+    limb_memory_resource
+    --------------------
+    Returns the memory resource that limb storage is allocated from on this
+    thread, which is null for the global heap.
+*/
+
+std::pmr::memory_resource*& limb_memory_resource() {
+    thread_local std::pmr::memory_resource* resource = nullptr;
+
+    return resource;
+}
+
+/*
+    BigIntMemoryScope
+    -----------------
+    Allocates the limbs of every BigInt created or grown on this thread from
+    a memory resource for as long as the scope lives, for example to run a
+    computation against a std::pmr::monotonic_buffer_resource and free it all
+    at once. Scopes nest.
+    NOTE: BigInts allocated within the scope must not outlive the resource;
+    copy results out (rather than moving them) after the scope has ended.
+*/
+
+class BigIntMemoryScope {
+    std::pmr::memory_resource* previous;
+
+   public:
+    explicit BigIntMemoryScope(std::pmr::memory_resource* resource)
+        : previous(limb_memory_resource()) {
+        limb_memory_resource() = resource;
+    }
+    ~BigIntMemoryScope() { limb_memory_resource() = previous; }
+
+    BigIntMemoryScope(const BigIntMemoryScope&) = delete;
+    BigIntMemoryScope& operator=(const BigIntMemoryScope&) = delete;
+};
+
+}  // namespace numericxx
+
+namespace numericxx::detail {
+
+/*
+    LimbVector
+    ----------
+    A vector of limbs that keeps up to two limbs (every magnitude below 2^128)
+    inline and only allocates on the heap for larger magnitudes, so that small
+    BigInts are no larger than a std::vector and never touch the allocator.
+    Heap storage comes from the memory resource of the thread at the time it
+    is allocated, which is remembered for freeing it.
+    Limbs added by `resize` are zero-initialised.
+*/
+
+class LimbVector {
+    static constexpr u32 INLINE_CAPACITY = 2;
+
+    struct HeapLimbs {
+        u64* limbs;
+        std::pmr::memory_resource* resource;  // null for the global heap
+    };
+
+    union {
+        u64 inline_limbs[INLINE_CAPACITY];
+        HeapLimbs heap;
+    };
+    u32 length;
+    u32 allocated;  // INLINE_CAPACITY while the limbs are stored inline
+
+    bool is_inline() const { return allocated == INLINE_CAPACITY; }
+
+    // Frees the heap limbs, if any, leaving the (zeroed) inline storage
+    // active so that `heap` is only ever read while it is live.
+    void release() {
+        if (!is_inline()) {
+            if (heap.resource)
+                heap.resource->deallocate(heap.limbs, allocated * sizeof(u64),
+                                          alignof(u64));
+            else
+                delete[] heap.limbs;
+        }
+        inline_limbs[0] = inline_limbs[1] = 0;
+        allocated = INLINE_CAPACITY;
+    }
+
+    void steal(LimbVector& other) {
+        if (other.is_inline()) {
+            inline_limbs[0] = other.inline_limbs[0];
+            inline_limbs[1] = other.inline_limbs[1];
+        } else {
+            heap = other.heap;
+        }
+        length = other.length;
+        allocated = other.allocated;
+
+        other.inline_limbs[0] = other.inline_limbs[1] = 0;
+        other.length = 0;
+        other.allocated = INLINE_CAPACITY;
+    }
+
+   public:
+    typedef u64* iterator;
+    typedef const u64* const_iterator;
+
+    LimbVector() : inline_limbs{}, length(0), allocated(INLINE_CAPACITY) {}
+    explicit LimbVector(size_t size) : LimbVector() { resize(size); }
+    LimbVector(const LimbVector& other) : LimbVector() {
+        assign(other.begin(), other.end());
+    }
+    LimbVector(LimbVector&& other) noexcept : LimbVector() { steal(other); }
+    ~LimbVector() { release(); }
+
+    LimbVector& operator=(const LimbVector& other) {
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    LimbVector& operator=(LimbVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    u64* data() { return is_inline() ? inline_limbs : heap.limbs; }
+    const u64* data() const { return is_inline() ? inline_limbs : heap.limbs; }
+    size_t size() const { return length; }
+    size_t capacity() const { return allocated; }
+    bool empty() const { return length == 0; }
+
+    u64& operator[](size_t i) { return data()[i]; }
+    const u64& operator[](size_t i) const { return data()[i]; }
+    u64& back() { return data()[length - 1]; }
+    const u64& back() const { return data()[length - 1]; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + length; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + length; }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity <= allocated) return;
+        if (new_capacity > U32_MAX) throw std::length_error("BigInt too large");
+
+        std::pmr::memory_resource* resource = limb_memory_resource();
+        u64* new_limbs =
+            resource ? static_cast<u64*>(resource->allocate(
+                           new_capacity * sizeof(u64), alignof(u64)))
+                     : new u64[new_capacity];
+        std::copy(begin(), end(), new_limbs);
+        release();
+        heap = {new_limbs, resource};
+        allocated = new_capacity;
+    }
+
+    void resize(size_t new_size) {
+        if (new_size > allocated)
+            reserve(std::max(new_size, 2 * (size_t)allocated));
+        if (new_size > length) std::fill(end(), data() + new_size, 0);
+        length = new_size;
+    }
+
+    void push_back(u64 limb) {
+        if (length == allocated) reserve(2 * (size_t)allocated);
+        data()[length++] = limb;
+    }
+
+    void pop_back() { length--; }
+    void clear() { length = 0; }
+
+    void assign(const u64* first, const u64* last) {
+        length = 0;
+        reserve(last - first);
+        std::copy(first, last, data());
+        length = last - first;
+    }
+
+    void assign(size_t size, u64 limb) {
+        length = 0;
+        reserve(size);
+        std::fill(data(), data() + size, limb);
+        length = size;
+    }
+
+    bool operator==(const LimbVector& other) const {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+};
+
+/*
+    ScratchArena
+    ------------
+    A stack of limb buffers for the temporaries of the multiplication and
+    division algorithms, bumped off blocks that are kept for reuse, so that
+    the recursive steps of an operation stop allocating once the blocks have
+    grown to its peak depth. Buffers are taken through a ScratchFrame and all
+    handed back together when it ends.
+    NOTE: blocks come from the global heap rather than the memory resource of
+    the thread, since they outlive any BigIntMemoryScope.
+*/
+
+class ScratchArena {
+    static constexpr size_t MIN_BLOCK_SIZE = 1024;
+
+    struct Block {
+        std::unique_ptr<u64[]> limbs;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0;  // block being bumped
+    size_t used = 0;     // limbs taken from the current block
+
+   public:
+    struct Mark {
+        size_t block, used;
+    };
+
+    Mark mark() const { return {current, used}; }
+
+    void release(Mark mark) {
+        current = mark.block;
+        used = mark.used;
+    }
+
+    u64* allocate(size_t size) {
+        while (current < blocks.size() and blocks[current].size - used < size) {
+            current++;
+            used = 0;
+        }
+        if (current == blocks.size()) {
+            size_t block_size = blocks.empty() ? MIN_BLOCK_SIZE
+                                               : 2 * blocks.back().size;
+            block_size = std::max(block_size, size);
+            blocks.push_back({std::unique_ptr<u64[]>(new u64[block_size]),
+                              block_size});
+        }
+
+        u64* limbs = blocks[current].limbs.get() + used;
+        used += size;
+        return limbs;
+    }
+};
+
+ScratchArena& scratch_arena() {
+    thread_local ScratchArena arena;
+
+    return arena;
+}
+
+/*
+    ScratchFrame
+    ------------
+    Takes uninitialised buffers from the scratch arena of the thread and
+    returns them all when it goes out of scope.
+*/
+
+class ScratchFrame {
+    ScratchArena& arena;
+    ScratchArena::Mark mark;
+
+   public:
+    ScratchFrame() : arena(scratch_arena()), mark(arena.mark()) {}
+    ~ScratchFrame() { arena.release(mark); }
+
+    ScratchFrame(const ScratchFrame&) = delete;
+    ScratchFrame& operator=(const ScratchFrame&) = delete;
+
+    u64* allocate(size_t size) { return arena.allocate(size); }
+};
+
+}  // namespace numericxx::detail
+
+#endif  // BIG_INT_LIMB_VECTOR_HPP
+
 /*
     ===========================================================================
     BigInt
@@ -20,41 +314,87 @@
 #ifndef BIG_INT_HPP
 #define BIG_INT_HPP
 
+#include <charconv>
+#include <compare>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "numericxx/montgomery.hpp"
+#include "numericxx/types.hpp"
+
+class BigIntView;
+class BarrettReducer;
+
+namespace numericxx::detail {
+template <class Node>
+struct LazyNode;
+}  // namespace numericxx::detail
 
 class BigInt {
-    std::string value;
+    // magnitude as base 2^64 limbs, least significant limb first, without
+    // leading zero limbs (zero has no limbs at all)
+    numericxx::detail::LimbVector limbs;
     char sign;
 
+    // Native fast path for values that fit in a signed 128-bit integer:
+    bool try_get_i128(numericxx::i128&) const;
+    void assign_i128(numericxx::i128);
+
+    // Adds a single limb with the given sign, for the integer operators:
+    void add_limb(numericxx::u64, char);
+    // Adds a product of magnitudes with the given sign, for the fused
+    // multiply-add functions:
+    void add_product(const numericxx::detail::LimbVector&,
+                     const numericxx::detail::LimbVector&, char);
+
    public:
     // Constructors:
     BigInt();
     BigInt(const BigInt&);
+    BigInt(BigInt&&) noexcept;
     BigInt(const long long&);
     BigInt(const std::string&);
 
     // Assignment operators:
     BigInt& operator=(const BigInt&);
+    BigInt& operator=(BigInt&&) noexcept;
     BigInt& operator=(const long long&);
     BigInt& operator=(const std::string&);
+    template <class Node>  // evaluates a lazy expression into this BigInt
+    BigInt& operator=(const numericxx::detail::LazyNode<Node>&);
 
     // Unary arithmetic operators:
-    BigInt operator+() const;  // unary +
-    BigInt operator-() const;  // unary -
+    BigInt operator+() const;   // unary +
+    BigInt operator-() const&;  // unary -
+    BigInt operator-() &&;
 
     // Binary arithmetic operators:
-    BigInt operator+(const BigInt&) const;
-    BigInt operator-(const BigInt&) const;
+    // (overloads taking rvalues reuse the storage of the temporary operand)
+    BigInt operator+(const BigInt&) const&;
+    BigInt operator+(const BigInt&) &&;
+    BigInt operator+(BigInt&&) const&;
+    BigInt operator+(BigInt&&) &&;
+    BigInt operator-(const BigInt&) const&;
+    BigInt operator-(const BigInt&) &&;
+    BigInt operator-(BigInt&&) const&;
+    BigInt operator-(BigInt&&) &&;
     BigInt operator*(const BigInt&) const;
     BigInt operator/(const BigInt&) const;
     BigInt operator%(const BigInt&) const;
-    BigInt operator+(const long long&) const;
-    BigInt operator-(const long long&) const;
+    BigInt operator+(const long long&) const&;
+    BigInt operator+(const long long&) &&;
+    BigInt operator-(const long long&) const&;
+    BigInt operator-(const long long&) &&;
     BigInt operator*(const long long&) const;
     BigInt operator/(const long long&) const;
     BigInt operator%(const long long&) const;
-    BigInt operator+(const std::string&) const;
-    BigInt operator-(const std::string&) const;
+    BigInt operator+(const std::string&) const&;
+    BigInt operator+(const std::string&) &&;
+    BigInt operator-(const std::string&) const&;
+    BigInt operator-(const std::string&) &&;
     BigInt operator*(const std::string&) const;
     BigInt operator/(const std::string&) const;
     BigInt operator%(const std::string&) const;
@@ -102,22 +442,160 @@ class BigInt {
     bool operator==(const std::string&) const;
     bool operator!=(const std::string&) const;
 
+    // Three-way comparison:
+    // (negative, zero or positive as *this is less than, equal to or greater)
+    int compare(const BigInt&) const;
+    int compare(const long long&) const;
+    int compare(std::string_view) const;
+    int compare(const std::string&) const;
+    int compare(const char*) const;
+    std::strong_ordering operator<=>(const BigInt&) const;
+    std::strong_ordering operator<=>(const long long&) const;
+    std::strong_ordering operator<=>(std::string_view) const;
+    std::strong_ordering operator<=>(const std::string&) const;
+    std::strong_ordering operator<=>(const char*) const;
+
+    // Bitwise operators:
+    // (with the semantics of an infinitely sign-extended two's complement)
+    BigInt operator~() const;
+    BigInt operator&(const BigInt&) const;
+    BigInt operator|(const BigInt&) const;
+    BigInt operator^(const BigInt&) const;
+    BigInt operator<<(size_t) const;
+    BigInt operator>>(size_t) const;
+    BigInt& operator&=(const BigInt&);
+    BigInt& operator|=(const BigInt&);
+    BigInt& operator^=(const BigInt&);
+    BigInt& operator<<=(size_t);
+    BigInt& operator>>=(size_t);
+
+    // Bit queries:
+    size_t bit_length() const;
+    size_t trailing_zeros() const;
+    size_t popcount() const;
+    bool test_bit(size_t) const;
+
     // I/O stream operators:
     friend std::istream& operator>>(std::istream&, BigInt&);
     friend std::ostream& operator<<(std::ostream&, const BigInt&);
 
     // Conversion functions:
+    friend size_t to_chars_size(const BigInt&, int);
+    friend std::to_chars_result to_chars(char*, char*, const BigInt&, int);
+    friend std::from_chars_result from_chars(const char*, const char*, BigInt&,
+                                             int);
     std::string to_string() const;
     int to_int() const;
     long to_long() const;
     long long to_long_long() const;
 
+    // Math functions:
+    friend BigInt square(const BigInt&);
+    friend BigInt big_pow10(size_t);
+    friend std::tuple<BigInt, BigInt> divmod(const BigInt&, const BigInt&);
+
+    // Fused multiply-add functions:
+    friend void addmul(BigInt&, const BigInt&, const BigInt&);
+    friend void submul(BigInt&, const BigInt&, const BigInt&);
+    friend void addmul(BigInt&, const BigInt&, const long long&);
+    friend void submul(BigInt&, const BigInt&, const long long&);
+    friend void mul_word_add(BigInt&, const long long&, const long long&);
+
     // Random number generating functions:
     friend BigInt gen_random(size_t);
+    template <class Engine>
+    friend BigInt random_bits(size_t, Engine&);
+    template <class Engine>
+    friend BigInt random_below(const BigInt&, Engine&);
+
+    // Lazy expressions:
+    template <class Expression>
+    friend BigInt& evaluate_into(BigInt&, const Expression&);
+
+    // Binary serialization:
+    friend size_t serialized_size(const BigInt&);
+    friend unsigned char* serialize(unsigned char*, const BigInt&);
+    friend std::ostream& serialize(std::ostream&, const BigInt&);
+    friend class BigIntView;
+
+    // Modular arithmetic:
+    friend class numericxx::MontgomeryContext<BigInt>;
+    friend class BarrettReducer;
 };
 
 #endif  // BIG_INT_HPP
 
+/*
+    ===========================================================================
+    Type specializations for BigInt
+    ===========================================================================
+*/
+#ifndef BIGINT_TYPE_SPECIALIZATIONS_HPP
+#define BIGINT_TYPE_SPECIALIZATIONS_HPP
+
+/**
+ * std::is_void<>
+ */
+template <>
+struct std::is_void<BigInt> : std::false_type {};
+
+/**
+ * std::is_null_pointer<>
+ */
+template <>
+struct std::is_null_pointer<BigInt> : std::false_type {};
+
+/**
+ * std::is_integral<>
+ */
+template <>
+struct std::is_integral<BigInt> : std::true_type {};
+
+/**
+ * std::is_floating_point<>
+ */
+template <>
+struct std::is_floating_point<BigInt> : std::false_type {};
+
+/**
+ * std::is_array<>
+ */
+template <>
+struct std::is_array<BigInt> : std::false_type {};
+
+/**
+ * std::is_enum<>
+ */
+template <>
+struct std::is_enum<BigInt> : std::false_type {};
+
+/**
+ * std::is_union<>
+ */
+template <>
+struct std::is_union<BigInt> : std::false_type {};
+
+/**
+ * std::is_class<>
+ * TODO: check if this is correct
+ */
+template <>
+struct std::is_class<BigInt> : std::true_type {};
+
+/**
+ * std::is_function<>
+ */
+template <>
+struct std::is_function<BigInt> : std::false_type {};
+
+/**
+ * std::is_pointer<>
+ */
+template <>
+struct std::is_pointer<BigInt> : std::false_type {};
+
+#endif // BIGINT_TYPE_SPECIALIZATIONS_HPP
+
 /*
     ===========================================================================
     Utility functions
@@ -127,6 +605,7 @@ class BigInt {
 #ifndef BIG_INT_UTILITY_FUNCTIONS_HPP
 #define BIG_INT_UTILITY_FUNCTIONS_HPP
 
+#include <algorithm>
 #include <tuple>
 
 /*
@@ -142,1586 +621,6145 @@ bool is_valid_number(const std::string& num) {
     return true;
 }
 
+namespace numericxx::detail {
+
 /*
-    strip_leading_zeroes
-    --------------------
-    Strip the leading zeroes from a number represented as a string.
+    strip_leading_zero_limbs
+    ------------------------
+    Strips the most significant zero limbs from a magnitude, leaving zero as an
+    empty vector.
 */
 
-void strip_leading_zeroes(std::string& num) {
-    size_t i;
-    for (i = 0; i < num.size(); i++)
-        if (num[i] != '0') break;
-
-    if (i == num.size())
-        num = "0";
-    else
-        num = num.substr(i);
+void strip_leading_zero_limbs(LimbVector& num) {
+    while (!num.empty() and num.back() == 0) num.pop_back();
 }
 
 /*
-    add_leading_zeroes
+    compare_magnitudes
     ------------------
-    Adds a given number of leading zeroes to a string-represented integer `num`.
+    Compares two magnitudes, returning a negative value, zero or a positive
+    value when `num1` is less than, equal to or greater than `num2`.
 */
 
-void add_leading_zeroes(std::string& num, size_t num_zeroes) {
-    num = std::string(num_zeroes, '0') + num;
+int compare_magnitudes(const LimbVector& num1,
+                       const LimbVector& num2) {
+    if (num1.size() != num2.size()) return num1.size() < num2.size() ? -1 : 1;
+    for (size_t i = num1.size(); i-- > 0;)
+        if (num1[i] != num2[i]) return num1[i] < num2[i] ? -1 : 1;
+
+    return 0;
 }
 
 /*
-    add_trailing_zeroes
-    -------------------
-    Adds a given number of trailing zeroes to a string-represented integer
-   `num`.
+    limbs_add
+    ---------
+    Adds the `size2`-limb number `num2` to the `size1`-limb number `num1` in a
+    single carry-propagating pass, writing the low `size1` limbs of the sum to
+    `result` and returning the carry out of the most significant limb.
+    NOTE: `size1` must not be less than `size2`. `result` must have room for
+    `size1` limbs and may be the same buffer as either operand, in which case
+    the unchanged high limbs of `num1` are not touched again.
 */
 
-void add_trailing_zeroes(std::string& num, size_t num_zeroes) {
-    num += std::string(num_zeroes, '0');
+u64 limbs_add(u64* result, const u64* num1, size_t size1, const u64* num2,
+              size_t size2) {
+    u64 carry = 0;
+    size_t i = 0;
+    for (; i < size2; i++) {
+        u128 sum = (u128)num1[i] + num2[i] + carry;
+        result[i] = (u64)sum;
+        carry = (u64)(sum >> 64);
+    }
+    for (; i < size1 and carry; i++) {
+        result[i] = num1[i] + 1;
+        carry = result[i] == 0;
+    }
+    if (result != num1) std::copy(num1 + i, num1 + size1, result + i);
+
+    return carry;
 }
 
 /*
-    get_larger_and_smaller
-    ----------------------
-    Identifies the given string-represented integers as `larger` and `smaller`,
-    padding the smaller number with leading zeroes to make it equal in length to
-    the larger number.
-*/
-
-std::tuple<std::string, std::string> get_larger_and_smaller(
-    const std::string& num1, const std::string& num2) {
-    std::string larger, smaller;
-    if (num1.size() > num2.size() or
-        (num1.size() == num2.size() and num1 > num2)) {
-        larger = num1;
-        smaller = num2;
-    } else {
-        larger = num2;
-        smaller = num1;
-    }
+    limbs_sub
+    ---------
+    Subtracts the `size2`-limb number `num2` from the `size1`-limb number
+    `num1` in a single borrow-propagating pass, writing the `size1` limbs of
+    the difference to `result` and returning the borrow out of the most
+    significant limb.
+    NOTE: `size1` must not be less than `size2`. `result` must have room for
+    `size1` limbs and may be the same buffer as either operand.
+*/
 
-    // pad the smaller number with zeroes
-    add_leading_zeroes(smaller, larger.size() - smaller.size());
+u64 limbs_sub(u64* result, const u64* num1, size_t size1, const u64* num2,
+              size_t size2) {
+    u64 borrow = 0;
+    size_t i = 0;
+    for (; i < size2; i++) {
+        u64 minuend = num1[i], subtrahend = num2[i];
+        result[i] = minuend - subtrahend - borrow;
+        borrow = (minuend < subtrahend) or (minuend - subtrahend < borrow);
+    }
+    for (; i < size1 and borrow; i++) {
+        u64 minuend = num1[i];
+        result[i] = minuend - 1;
+        borrow = minuend == 0;
+    }
+    if (result != num1) std::copy(num1 + i, num1 + size1, result + i);
 
-    return std::make_tuple(larger, smaller);
+    return borrow;
 }
 
 /*
-    is_power_of_10
-    ----------------------
-    Checks whether a string-represented integer is a power of 10.
+    limbs_add_1
+    -----------
+    Adds a single limb to the `size`-limb number `num`, writing the `size`
+    limbs of the sum to `result` and returning the carry out of them.
+    NOTE: `result` may be the same buffer as `num`.
 */
 
-bool is_power_of_10(const std::string& num) {
-    if (num[0] != '1') return false;
-    for (size_t i = 1; i < num.size(); i++)
-        if (num[i] != '0') return false;
+u64 limbs_add_1(u64* result, const u64* num, size_t size, u64 addend) {
+    size_t i = 0;
+    for (; i < size and addend; i++) {
+        result[i] = num[i] + addend;
+        addend = result[i] < addend;
+    }
+    if (result != num) std::copy(num + i, num + size, result + i);
 
-    return true;  // first digit is 1 and the following digits are all 0
+    return addend;
 }
 
-#endif  // BIG_INT_UTILITY_FUNCTIONS_HPP
-
 /*
-    ===========================================================================
-    Random number generating functions for BigInt
-    ===========================================================================
+    limbs_sub_1
+    -----------
+    Subtracts a single limb from the `size`-limb number `num`, writing the
+    `size` limbs of the difference to `result` and returning the borrow out of
+    them.
+    NOTE: `result` may be the same buffer as `num`.
 */
 
-#ifndef BIG_INT_RANDOM_FUNCTIONS_HPP
-#define BIG_INT_RANDOM_FUNCTIONS_HPP
-
-#include <climits>
-#include <random>
+u64 limbs_sub_1(u64* result, const u64* num, size_t size, u64 subtrahend) {
+    size_t i = 0;
+    for (; i < size and subtrahend; i++) {
+        u64 minuend = num[i];
+        result[i] = minuend - subtrahend;
+        subtrahend = minuend < subtrahend;
+    }
+    if (result != num) std::copy(num + i, num + size, result + i);
 
-// when the number of digits are not specified, a random value is used for it
-// which is kept below the following:
-const size_t MAX_RANDOM_LENGTH = 1000;
+    return subtrahend;
+}
 
 /*
-    big_random (num_digits)
-    -----------------------
-    Returns a random BigInt with a specific number of digits.
+    limbs_negate
+    ------------
+    Replaces the `size`-limb number `num` with B^size - num, its two's
+    complement negation.
 */
 
-BigInt gen_random(size_t num_digits = 0) {
-    std::random_device rand_generator;  // true random number generator
-
-    if (num_digits == 0)  // the number of digits were not specified
-        // use a random number for it:
-        num_digits = 1 + rand_generator() % MAX_RANDOM_LENGTH;
+void limbs_negate(u64* num, size_t size) {
+    for (size_t i = 0; i < size; i++) num[i] = ~num[i];
+    limbs_add_1(num, num, size, 1);
+}
 
-    BigInt big_rand;
-    big_rand.value = "";  // clear value to append digits
+/*
+    add_magnitudes
+    --------------
+    Returns the sum of two magnitudes.
+*/
 
-    // ensure that the first digit is non-zero
-    big_rand.value += std::to_string(1 + rand_generator() % 9);
+LimbVector add_magnitudes(const LimbVector& num1,
+                                const LimbVector& num2) {
+    const LimbVector& larger = num1.size() >= num2.size() ? num1 : num2;
+    const LimbVector& smaller = num1.size() >= num2.size() ? num2 : num1;
 
-    while (big_rand.value.size() < num_digits)
-        big_rand.value += std::to_string(rand_generator());
-    if (big_rand.value.size() != num_digits)
-        big_rand.value.erase(num_digits);  // erase extra digits
+    LimbVector sum(larger.size() + 1);
+    sum.back() = limbs_add(sum.data(), larger.data(), larger.size(),
+                           smaller.data(), smaller.size());
+    strip_leading_zero_limbs(sum);
 
-    return big_rand;
+    return sum;
 }
 
-#endif  // BIG_INT_RANDOM_FUNCTIONS_HPP
-
 /*
-    ===========================================================================
-    Constructors
-    ===========================================================================
+    subtract_magnitudes
+    -------------------
+    Returns the difference `larger - smaller` of two magnitudes.
+    NOTE: `larger` must not be less than `smaller`.
 */
 
-#ifndef BIG_INT_CONSTRUCTORS_HPP
-#define BIG_INT_CONSTRUCTORS_HPP
+LimbVector subtract_magnitudes(const LimbVector& larger,
+                                     const LimbVector& smaller) {
+    LimbVector difference(larger.size());
+    limbs_sub(difference.data(), larger.data(), larger.size(), smaller.data(),
+              smaller.size());
+    strip_leading_zero_limbs(difference);
+
+    return difference;
+}
 
 /*
-    Default constructor
-    -------------------
+    add_magnitudes_in_place
+    -----------------------
+    Adds the magnitude `num2` to the magnitude `num1`, reusing the storage of
+    `num1` for the sum.
 */
 
-BigInt::BigInt() {
-    value = "0";
-    sign = '+';
+void add_magnitudes_in_place(LimbVector& num1,
+                             const LimbVector& num2) {
+    if (num1.size() < num2.size()) num1.resize(num2.size());
+
+    u64 carry = limbs_add(num1.data(), num1.data(), num1.size(), num2.data(),
+                          num2.size());
+    if (carry) num1.push_back(carry);
 }
 
 /*
-    Copy constructor
-    ----------------
+    subtract_magnitudes_in_place
+    ----------------------------
+    Replaces the magnitude `num1` by the absolute difference between it and the
+    magnitude `num2`, reusing the storage of `num1`. Returns true if `num2` was
+    the larger of the two, i.e. if the difference changes sign.
 */
 
-BigInt::BigInt(const BigInt& num) {
-    value = num.value;
-    sign = num.sign;
+bool subtract_magnitudes_in_place(LimbVector& num1,
+                                  const LimbVector& num2) {
+    bool flipped = compare_magnitudes(num1, num2) < 0;
+    if (flipped) {
+        size_t size1 = num1.size();
+        num1.resize(num2.size());
+        limbs_sub(num1.data(), num2.data(), num2.size(), num1.data(), size1);
+    } else
+        limbs_sub(num1.data(), num1.data(), num1.size(), num2.data(),
+                  num2.size());
+    strip_leading_zero_limbs(num1);
+
+    return flipped;
 }
 
 /*
-    Integer to BigInt
+    multiply_add_limb
     -----------------
+    Replaces a magnitude `num` by `num * multiplier + addend`.
 */
 
-BigInt::BigInt(const long long& num) {
-    value = std::to_string(std::abs(num));
-    if (num < 0)
-        sign = '-';
-    else
-        sign = '+';
+void multiply_add_limb(LimbVector& num, u64 multiplier, u64 addend) {
+    u128 carry = addend;
+    for (u64& limb : num) {
+        carry += (u128)limb * multiplier;
+        limb = (u64)carry;
+        carry >>= 64;
+    }
+    if (carry) num.push_back((u64)carry);
 }
 
 /*
-    String to BigInt
-    ----------------
+    LimbDivisor
+    -----------
+    A single-limb divisor prepared for repeated division: the divisor shifted
+    so that its top bit is set, and its reciprocal floor((B^2 - 1) / d) - B
+    for the shifted divisor d, with B = 2^64. Division by it then costs two
+    multiplications per limb instead of a 128-bit hardware division (Moller
+    and Granlund, "Improved division by invariant integers", 2011).
 */
 
-BigInt::BigInt(const std::string& num) {
-    if (num[0] == '+' || num[0] == '-') {  // check for sign
-        std::string magnitude = num.substr(1);
-        if (is_valid_number(magnitude)) {
-            value = magnitude;
-            sign = num[0];
-        } else {
-            throw std::invalid_argument("Expected an integer, got \'" + num +
-                                        "\'");
+struct LimbDivisor {
+    u64 divisor;
+    unsigned shift;
+    u64 reciprocal;
+
+    explicit LimbDivisor(u64 num)
+        : divisor(num << __builtin_clzll(num)),
+          shift(__builtin_clzll(num)),
+          reciprocal((u64)((((u128)~divisor) << 64 | U64_MAX) / divisor)) {}
+
+    // Divides high:low by the shifted divisor, where high < divisor,
+    // returning the quotient and storing the remainder in `high`.
+    u64 divide(u64& high, u64 low) const {
+        u128 estimate = (u128)reciprocal * high +
+                        (((u128)(high + 1) << 64) | low);
+        u64 quotient = (u64)(estimate >> 64);
+        u64 remainder = low - quotient * divisor;
+        if (remainder > (u64)estimate) {
+            quotient--;
+            remainder += divisor;
         }
-    } else {  // if no sign is specified
-        if (is_valid_number(num)) {
-            value = num;
-            sign = '+';  // positive by default
-        } else {
-            throw std::invalid_argument("Expected an integer, got \'" + num +
-                                        "\'");
+        if (remainder >= divisor) {
+            quotient++;
+            remainder -= divisor;
         }
-    }
-    strip_leading_zeroes(value);
-}
 
-#endif  // BIG_INT_CONSTRUCTORS_HPP
+        high = remainder;
+        return quotient;
+    }
+};
 
 /*
-    ===========================================================================
-    Conversion functions for BigInt
-    ===========================================================================
+    limbs_divrem_1
+    --------------
+    Divides the `size`-limb number `num` by a prepared single-limb divisor,
+    writing the `size` quotient limbs to `quotient` and returning the
+    remainder.
+    NOTE: `quotient` may be the same buffer as `num`.
 */
 
-#ifndef BIG_INT_CONVERSION_FUNCTIONS_HPP
-#define BIG_INT_CONVERSION_FUNCTIONS_HPP
-
-/*
-    to_string
-    ---------
-    Converts a BigInt to a string.
-*/
+u64 limbs_divrem_1(u64* quotient, const u64* num, size_t size,
+                   const LimbDivisor& divisor) {
+    if (size == 0) return 0;
+
+    // divide num * 2^shift by the shifted divisor, a limb at a time
+    unsigned shift = divisor.shift;
+    u64 remainder = shift ? num[size - 1] >> (64 - shift) : 0;
+    for (size_t i = size; i-- > 0;) {
+        u64 limb = num[i] << shift;
+        if (shift and i > 0) limb |= num[i - 1] >> (64 - shift);
+        quotient[i] = divisor.divide(remainder, limb);
+    }
 
-std::string BigInt::to_string() const {
-    // prefix with sign if negative
-    return this->sign == '-' ? "-" + this->value : this->value;
+    return remainder >> shift;
 }
 
 /*
-    to_int
-    ------
-    Converts a BigInt to an int.
-    NOTE: If the BigInt is out of range of an int, stoi() will throw an
-    out_of_range exception.
+    limbs_mod_1
+    -----------
+    Returns the remainder on dividing the `size`-limb number `num` by a
+    prepared single-limb divisor.
 */
 
-int BigInt::to_int() const { return std::stoi(this->to_string()); }
+u64 limbs_mod_1(const u64* num, size_t size, const LimbDivisor& divisor) {
+    if (size == 0) return 0;
 
-/*
-    to_long
-    -------
-    Converts a BigInt to a long int.
-    NOTE: If the BigInt is out of range of a long int, stol() will throw an
-    out_of_range exception.
-*/
+    unsigned shift = divisor.shift;
+    u64 remainder = shift ? num[size - 1] >> (64 - shift) : 0;
+    for (size_t i = size; i-- > 0;) {
+        u64 limb = num[i] << shift;
+        if (shift and i > 0) limb |= num[i - 1] >> (64 - shift);
+        divisor.divide(remainder, limb);
+    }
 
-long BigInt::to_long() const { return std::stol(this->to_string()); }
+    return remainder >> shift;
+}
 
 /*
-    to_long_long
-    ------------
-    Converts a BigInt to a long long int.
-    NOTE: If the BigInt is out of range of a long long int, stoll() will throw
-    an out_of_range exception.
+    divide_magnitude_by_limb
+    ------------------------
+    Returns the quotient and remainder on dividing a magnitude by a non-zero
+    single limb.
 */
 
-long long BigInt::to_long_long() const { return std::stoll(this->to_string()); }
+std::tuple<LimbVector, u64> divide_magnitude_by_limb(
+    const LimbVector& dividend, u64 divisor) {
+    LimbVector quotient(dividend.size());
+    u64 remainder = limbs_divrem_1(quotient.data(), dividend.data(),
+                                   dividend.size(), LimbDivisor(divisor));
+    strip_leading_zero_limbs(quotient);
 
-#endif  // BIG_INT_CONVERSION_FUNCTIONS_HPP
+    return std::make_tuple(quotient, remainder);
+}
+
+}  // namespace numericxx::detail
+
+#endif  // BIG_INT_UTILITY_FUNCTIONS_HPP
 
 /*
     ===========================================================================
-    Assignment operators
+    Multiplication algorithms
     ===========================================================================
+    Schoolbook, Karatsuba, Toom-Cook and NTT multiplication of limb buffers.
+    The algorithm is picked by the size of the smaller operand, using the
+    thresholds in numericxx/config.hpp.
 */
 
-#ifndef BIG_INT_ASSIGNMENT_OPERATORS_HPP
-#define BIG_INT_ASSIGNMENT_OPERATORS_HPP
+#ifndef BIG_INT_MULTIPLICATION_HPP
+#define BIG_INT_MULTIPLICATION_HPP
+
+#include <vector>
+
+#include "numericxx/config.hpp"
+
+namespace numericxx::detail {
+
+void limbs_mul(u64*, const u64*, size_t, const u64*, size_t);
+void limbs_sqr(u64*, const u64*, size_t);
+LimbVector multiply_magnitudes(const LimbVector&, const LimbVector&);
+LimbVector square_magnitude(const LimbVector&);
 
 /*
-    BigInt = BigInt
-    ---------------
+    limbs_mul_1
+    -----------
+    Multiplies the `size`-limb number `num` by a single limb, writing the low
+    `size` limbs of the product to `result` and returning the high limb.
 */
 
-BigInt& BigInt::operator=(const BigInt& num) {
-    value = num.value;
-    sign = num.sign;
+u64 limbs_mul_1(u64* result, const u64* num, size_t size, u64 multiplier) {
+    u64 carry = 0;
+    for (size_t i = 0; i < size; i++) {
+        u128 product = (u128)num[i] * multiplier + carry;
+        result[i] = (u64)product;
+        carry = (u64)(product >> 64);
+    }
 
-    return *this;
+    return carry;
 }
 
 /*
-    BigInt = Integer
-    ----------------
+    limbs_addmul_1
+    --------------
+    Adds the product of the `size`-limb number `num` and a single limb to the
+    `size` limbs at `result`, returning the limb carried out of them.
 */
 
-BigInt& BigInt::operator=(const long long& num) {
-    BigInt temp(num);
-    value = temp.value;
-    sign = temp.sign;
+u64 limbs_addmul_1(u64* result, const u64* num, size_t size, u64 multiplier) {
+    u64 carry = 0;
+    for (size_t i = 0; i < size; i++) {
+        u128 product = (u128)num[i] * multiplier + result[i] + carry;
+        result[i] = (u64)product;
+        carry = (u64)(product >> 64);
+    }
 
-    return *this;
+    return carry;
 }
 
 /*
-    BigInt = String
-    ---------------
+    limbs_submul_1
+    --------------
+    Subtracts the product of the `size`-limb number `num` and a single limb
+    from the `size` limbs at `result`, returning the limb borrowed from above
+    them.
 */
 
-BigInt& BigInt::operator=(const std::string& num) {
-    BigInt temp(num);
-    value = temp.value;
-    sign = temp.sign;
+u64 limbs_submul_1(u64* result, const u64* num, size_t size, u64 multiplier) {
+    u64 borrow = 0;
+    for (size_t i = 0; i < size; i++) {
+        u128 product = (u128)num[i] * multiplier + borrow;
+        u64 low = (u64)product;
+        borrow = (u64)(product >> 64) + (result[i] < low);
+        result[i] -= low;
+    }
 
-    return *this;
+    return borrow;
 }
 
-#endif  // BIG_INT_ASSIGNMENT_OPERATORS_HPP
-
 /*
-    ===========================================================================
-    Unary arithmetic operators
-    ===========================================================================
+    limbs_lshift
+    ------------
+    Shifts a `size`-limb number left by `shift` bits, 0 <= shift < 64, writing
+    the low `size` limbs to `result` and returning the bits shifted out.
+    NOTE: `result` may be the same buffer as `num`.
 */
 
-#ifndef BIG_INT_UNARY_ARITHMETIC_OPERATORS_HPP
-#define BIG_INT_UNARY_ARITHMETIC_OPERATORS_HPP
+u64 limbs_lshift(u64* result, const u64* num, size_t size, unsigned shift) {
+    if (shift == 0) {
+        std::copy(num, num + size, result);
+        return 0;
+    }
 
-/*
-    +BigInt
-    -------
-    Returns the value of a BigInt.
-    NOTE: This function does not return the absolute value. To get the absolute
-    value of a BigInt, use the `abs` function.
-*/
+    u64 carry = 0;
+    for (size_t i = 0; i < size; i++) {
+        u64 limb = num[i];
+        result[i] = (limb << shift) | carry;
+        carry = limb >> (64 - shift);
+    }
 
-BigInt BigInt::operator+() const { return *this; }
+    return carry;
+}
 
 /*
-    -BigInt
-    -------
-    Returns the negative of a BigInt.
+    limbs_rshift
+    ------------
+    Shifts a `size`-limb number right by `shift` bits, 0 <= shift < 64,
+    writing the `size` limbs to `result`.
+    NOTE: `result` may be the same buffer as `num`.
 */
 
-BigInt BigInt::operator-() const {
-    BigInt temp;
-
-    temp.value = value;
-    if (value != "0") {
-        if (sign == '+')
-            temp.sign = '-';
-        else
-            temp.sign = '+';
+void limbs_rshift(u64* result, const u64* num, size_t size, unsigned shift) {
+    if (shift == 0) {
+        std::copy(num, num + size, result);
+        return;
     }
 
-    return temp;
+    for (size_t i = 0; i < size; i++) {
+        u64 high = i + 1 < size ? num[i + 1] << (64 - shift) : 0;
+        result[i] = (num[i] >> shift) | high;
+    }
 }
 
-#endif  // BIG_INT_UNARY_ARITHMETIC_OPERATORS_HPP
-
 /*
-    ===========================================================================
-    Relational operators
-    ===========================================================================
-    All operators depend on the '<' and/or '==' operator(s).
+    limbs_cmp
+    ---------
+    Compares two numbers of possibly different limb counts, either of which may
+    have leading zero limbs.
 */
 
-#ifndef BIG_INT_RELATIONAL_OPERATORS_HPP
-#define BIG_INT_RELATIONAL_OPERATORS_HPP
+int limbs_cmp(const u64* num1, size_t size1, const u64* num2, size_t size2) {
+    for (; size1 > size2; size1--)
+        if (num1[size1 - 1]) return 1;
+    for (; size2 > size1; size2--)
+        if (num2[size2 - 1]) return -1;
+    for (size_t i = size1; i-- > 0;)
+        if (num1[i] != num2[i]) return num1[i] < num2[i] ? -1 : 1;
+
+    return 0;
+}
 
 /*
-    BigInt == BigInt
-    ----------------
+    limbs_mul_basecase
+    ------------------
+    Schoolbook multiplication, one row of `limbs_addmul_1` per limb of `num2`.
+    NOTE: `result` must have room for `size1 + size2` limbs and must not
+    overlap either operand; `size2` must be non-zero.
 */
 
-bool BigInt::operator==(const BigInt& num) const {
-    return (sign == num.sign) and (value == num.value);
+void limbs_mul_basecase(u64* result, const u64* num1, size_t size1,
+                        const u64* num2, size_t size2) {
+    result[size1] = limbs_mul_1(result, num1, size1, num2[0]);
+    for (size_t i = 1; i < size2; i++)
+        result[size1 + i] = limbs_addmul_1(result + i, num1, size1, num2[i]);
 }
 
 /*
-    BigInt != BigInt
-    ----------------
+    limbs_mul_karatsuba
+    -------------------
+    Karatsuba multiplication of operands split at `half` limbs, as
+        num1 * num2 = z2 * B^(2 * half) + z1 * B^half + z0
+    where z1 = z2 + z0 - (num1_low - num1_high) * (num2_low - num2_high).
+    NOTE: expects `size1 >= size2 > size1 / 2`.
 */
 
-bool BigInt::operator!=(const BigInt& num) const { return !(*this == num); }
+void limbs_mul_karatsuba(u64* result, const u64* num1, size_t size1,
+                         const u64* num2, size_t size2) {
+    size_t half = (size1 + 1) / 2;
+    size_t high1 = size1 - half, high2 = size2 - half;
 
-/*
-    BigInt < BigInt
-    ---------------
-*/
+    // z0 and z2 are computed directly into the low and high parts of `result`
+    limbs_mul(result, num1, half, num2, half);
+    if (high2)
+        limbs_mul(result + 2 * half, num1 + half, high1, num2 + half, high2);
+    else
+        std::fill(result + 2 * half, result + size1 + size2, 0);
+
+    // |num1_low - num1_high| and |num2_low - num2_high|, with their signs
+    ScratchFrame scratch;
+    u64* diff1 = scratch.allocate(half);
+    u64* diff2 = scratch.allocate(half);
+    bool negative = false;
+    if (limbs_cmp(num1, half, num1 + half, high1) >= 0)
+        limbs_sub(diff1, num1, half, num1 + half, high1);
+    else {
+        std::copy(num1 + half, num1 + size1, diff1);
+        std::fill(diff1 + high1, diff1 + half, 0);
+        limbs_sub(diff1, diff1, half, num1, half);
+        negative = !negative;
+    }
+    if (limbs_cmp(num2, half, num2 + half, high2) >= 0)
+        limbs_sub(diff2, num2, half, num2 + half, high2);
+    else {
+        std::copy(num2 + half, num2 + size2, diff2);
+        std::fill(diff2 + high2, diff2 + half, 0);
+        limbs_sub(diff2, diff2, half, num2, half);
+        negative = !negative;
+    }
 
-bool BigInt::operator<(const BigInt& num) const {
-    if (sign == num.sign) {
-        if (sign == '+') {
-            if (value.length() == num.value.length())
-                return value < num.value;
-            else
-                return value.length() < num.value.length();
-        } else
-            return -(*this) > -num;
-    } else
-        return sign == '-';
+    u64* diff_product = scratch.allocate(2 * half);
+    limbs_mul(diff_product, diff1, half, diff2, half);
+
+    // z1 = z0 + z2 -/+ diff_product, which is never negative
+    size_t high_size = high1 + high2;
+    u64* middle = scratch.allocate(2 * half + 1);
+    middle[2 * half] =
+        limbs_add(middle, result, 2 * half, result + 2 * half, high_size);
+    if (negative)
+        limbs_add(middle, middle, 2 * half + 1, diff_product, 2 * half);
+    else
+        limbs_sub(middle, middle, 2 * half + 1, diff_product, 2 * half);
+
+    // z1 fits in the product, so the carry out of this addition is always 0
+    size_t middle_size = std::min(2 * half + 1, size1 + size2 - half);
+    limbs_add(result + half, result + half, size1 + size2 - half, middle,
+              middle_size);
 }
 
 /*
-    BigInt > BigInt
-    ---------------
+    limbs_sqr_basecase
+    ------------------
+    Schoolbook squaring, which computes each cross product num[i] * num[j]
+    with i < j only once, doubles their sum and adds the squares of the limbs
+    on the diagonal.
+    NOTE: `result` must have room for `2 * size` limbs and must not overlap
+    `num`; `size` must be non-zero.
 */
 
-bool BigInt::operator>(const BigInt& num) const {
-    return !((*this < num) or (*this == num));
+void limbs_sqr_basecase(u64* result, const u64* num, size_t size) {
+    std::fill(result, result + 2 * size, 0);
+    for (size_t i = 0; i + 1 < size; i++)
+        result[size + i] = limbs_addmul_1(result + 2 * i + 1, num + i + 1,
+                                          size - i - 1, num[i]);
+
+    u64 carry = 0;
+    for (size_t i = 0; i < 2 * size; i++) {
+        u64 limb = result[i];
+        result[i] = (limb << 1) | carry;
+        carry = limb >> 63;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        u128 square = (u128)num[i] * num[i];
+        u128 low = (u128)result[2 * i] + (u64)square + carry;
+        u128 high = (u128)result[2 * i + 1] + (u64)(square >> 64) +
+                    (u64)(low >> 64);
+        result[2 * i] = (u64)low;
+        result[2 * i + 1] = (u64)high;
+        carry = (u64)(high >> 64);
+    }
 }
 
 /*
-    BigInt <= BigInt
-    ----------------
+    limbs_sqr_karatsuba
+    -------------------
+    Karatsuba squaring, where the middle term is z2 + z0 - (low - high)^2 and
+    all three products are squares.
 */
 
-bool BigInt::operator<=(const BigInt& num) const {
-    return (*this < num) or (*this == num);
+void limbs_sqr_karatsuba(u64* result, const u64* num, size_t size) {
+    size_t half = (size + 1) / 2, high = size - half;
+
+    limbs_sqr(result, num, half);
+    limbs_sqr(result + 2 * half, num + half, high);
+
+    ScratchFrame scratch;
+    u64* diff = scratch.allocate(half);
+    if (limbs_cmp(num, half, num + half, high) >= 0)
+        limbs_sub(diff, num, half, num + half, high);
+    else {
+        std::copy(num + half, num + size, diff);
+        std::fill(diff + high, diff + half, 0);
+        limbs_sub(diff, diff, half, num, half);
+    }
+
+    u64* diff_square = scratch.allocate(2 * half);
+    limbs_sqr(diff_square, diff, half);
+
+    u64* middle = scratch.allocate(2 * half + 1);
+    middle[2 * half] =
+        limbs_add(middle, result, 2 * half, result + 2 * half, 2 * high);
+    limbs_sub(middle, middle, 2 * half + 1, diff_square, 2 * half);
+
+    size_t middle_size = std::min(2 * half + 1, 2 * size - half);
+    limbs_add(result + half, result + half, 2 * size - half, middle,
+              middle_size);
 }
 
 /*
-    BigInt >= BigInt
+    limbs_divexact_1
     ----------------
+    Divides the `size`-limb number `num` in place by an odd single limb that
+    is known to divide it, by multiplying each limb by the inverse of the
+    divisor modulo 2^64 (Hensel division), which needs no quotient estimates.
 */
 
-bool BigInt::operator>=(const BigInt& num) const { return !(*this < num); }
+void limbs_divexact_1(u64* num, size_t size, u64 divisor) {
+    u64 inverse = inverse_mod_word(divisor);
+    u64 borrow = 0;
+    for (size_t i = 0; i < size; i++) {
+        u64 limb = num[i];
+        u64 quotient = (limb - borrow) * inverse;
+        num[i] = quotient;
+        borrow = (u64)(((u128)quotient * divisor) >> 64) + (limb < borrow);
+    }
+}
 
 /*
-    BigInt == Integer
-    -----------------
+    Toom-Cook multiplication
+    ------------------------
+    Toom-k splits both operands into `k` pieces of `piece` limbs, read as the
+    coefficients of polynomials A(x) and B(x) with A(B^piece) = num1. The
+    product C(x) = A(x) * B(x) is evaluated at 2k - 1 points by recursive
+    multiplication and recovered from those values by a fixed interpolation
+    sequence of additions, shifts and exact divisions by small odd numbers.
+
+    The points are 0, 1, -1, 2 and infinity for Toom-3, and additionally -2
+    and 1/2 for Toom-4. Pairing each point x with -x separates the even and
+    odd coefficients of C, so every intermediate value of the interpolation is
+    non-negative and fits in `2 * piece + 2` limbs; only the evaluations at the
+    negative points need a sign. C(0) and C(infinity) are the products of the
+    lowest and highest pieces, which are written straight to the bottom and top
+    of `result`.
+
+    The evaluations and products live in `ScratchArena` buffers, and squaring
+    evaluates the operand once per point and squares the values recursively.
+    NOTE: expects `size1 >= size2 > size1 / 2`, and `result` must have room
+    for `size1 + size2` limbs and must not overlap either operand.
 */
 
-bool BigInt::operator==(const long long& num) const {
-    return *this == BigInt(num);
+// Number of limbs of the `i`-th piece of a `size`-limb number, which is short
+// or empty for the top pieces
+size_t toom_piece_size(size_t size, size_t piece, size_t i) {
+    return i * piece < size ? std::min(piece, size - i * piece) : 0;
 }
 
-/*
-    Integer == BigInt
-    -----------------
-*/
-
-bool operator==(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) == rhs;
+// Copies a piece of `size` limbs into a buffer of `width` limbs, zero-padded
+void toom_load_piece(u64* buffer, size_t width, const u64* num, size_t size) {
+    std::copy(num, num + size, buffer);
+    std::fill(buffer + size, buffer + width, 0);
 }
 
-/*
-    BigInt != Integer
-    -----------------
-*/
+// Writes `even + odd` to `sum` and `|even - odd|` to `difference`, all of
+// `size` limbs, returning true if the difference is negative
+bool toom_sum_and_difference(u64* sum, u64* difference, const u64* even,
+                             const u64* odd, size_t size) {
+    limbs_add(sum, even, size, odd, size);
+    if (limbs_cmp(even, size, odd, size) >= 0) {
+        limbs_sub(difference, even, size, odd, size);
+        return false;
+    }
 
-bool BigInt::operator!=(const long long& num) const {
-    return !(*this == BigInt(num));
+    limbs_sub(difference, odd, size, even, size);
+    return true;
 }
 
-/*
-    Integer != BigInt
-    -----------------
-*/
+// Adds the `size`-limb coefficient of x^i into the product at `offset` limbs,
+// dropping its high limbs beyond the product, which are zero
+void toom_add_coefficient(u64* result, size_t size, size_t offset,
+                          const u64* coefficient, size_t coefficient_size) {
+    if (offset >= size) return;
 
-bool operator!=(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) != rhs;
+    limbs_add(result + offset, result + offset, size - offset, coefficient,
+              std::min(coefficient_size, size - offset));
 }
 
 /*
-    BigInt < Integer
-    ----------------
+    toom3_evaluate
+    --------------
+    Evaluates A(x) for the 3-piece split of a `size`-limb number at 1, -1 and
+    2, writing `piece + 1` limbs each to `values` in that order. The value at
+    -1 is written as a magnitude, and the function returns true if it is
+    negative.
 */
 
-bool BigInt::operator<(const long long& num) const {
-    return *this < BigInt(num);
+bool toom3_evaluate(u64* values, const u64* num, size_t size, size_t piece) {
+    size_t width = piece + 1;
+    size_t size1 = toom_piece_size(size, piece, 1);
+    size_t size2 = toom_piece_size(size, piece, 2);
+    const u64 *piece1 = num + piece, *piece2 = num + 2 * piece;
+
+    ScratchFrame scratch;
+    u64* even = scratch.allocate(width);
+    u64* odd = scratch.allocate(width);
+    even[piece] = limbs_add(even, num, piece, piece2, size2);
+    toom_load_piece(odd, width, piece1, size1);
+    bool negative = toom_sum_and_difference(values, values + width, even, odd,
+                                            width);
+
+    // A(2) = (2 * x2 + x1) * 2 + x0
+    u64* at2 = values + 2 * width;
+    toom_load_piece(at2, width, piece2, size2);
+    limbs_lshift(at2, at2, width, 1);
+    limbs_add(at2, at2, width, piece1, size1);
+    limbs_lshift(at2, at2, width, 1);
+    limbs_add(at2, at2, width, num, piece);
+
+    return negative;
 }
 
 /*
-    Integer < BigInt
-    ----------------
+    toom3_interpolate
+    -----------------
+    Recovers the coefficients of C(x) from its values at 1, -1 and 2, each of
+    `2 * piece + 2` limbs, and adds them into `result`, whose `size` limbs
+    already hold C(0) at the bottom, `vinf_size` limbs of C(infinity) at
+    `4 * piece` limbs and zeros in between. The values are overwritten.
 */
 
-bool operator<(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) < rhs;
+void toom3_interpolate(u64* result, size_t size, size_t piece, u64* at1,
+                       u64* at_minus1, bool minus1_negative, u64* at2,
+                       size_t vinf_size) {
+    size_t width = 2 * piece + 2;
+    const u64* at0 = result;
+    const u64* vinf = result + 4 * piece;
+
+    // at_minus1 = (C(1) - C(-1)) / 2 = c1 + c3
+    if (minus1_negative)
+        limbs_add(at_minus1, at1, width, at_minus1, width);
+    else
+        limbs_sub(at_minus1, at1, width, at_minus1, width);
+    limbs_rshift(at_minus1, at_minus1, width, 1);
+
+    // at1 = (C(1) + C(-1)) / 2 - c0 - c4 = c2
+    limbs_sub(at1, at1, width, at_minus1, width);
+    limbs_sub(at1, at1, width, at0, 2 * piece);
+    limbs_sub(at1, at1, width, vinf, vinf_size);
+
+    // at2 = ((C(2) - c0) / 2 - (c1 + c3) - 2 * c2 - 8 * c4) / 3 = c3
+    limbs_sub(at2, at2, width, at0, 2 * piece);
+    limbs_rshift(at2, at2, width, 1);
+    limbs_sub(at2, at2, width, at_minus1, width);
+    limbs_submul_1(at2, at1, width, 2);
+    u64 borrow = limbs_submul_1(at2, vinf, vinf_size, 8);
+    limbs_sub_1(at2 + vinf_size, at2 + vinf_size, width - vinf_size, borrow);
+    limbs_divexact_1(at2, width, 3);
+
+    // at_minus1 = (c1 + c3) - c3 = c1
+    limbs_sub(at_minus1, at_minus1, width, at2, width);
+
+    toom_add_coefficient(result, size, piece, at_minus1, width);
+    toom_add_coefficient(result, size, 2 * piece, at1, width);
+    toom_add_coefficient(result, size, 3 * piece, at2, width);
 }
 
 /*
-    BigInt > Integer
-    ----------------
+    limbs_mul_toom3
+    ---------------
+    Toom-3 multiplication; see "Toom-Cook multiplication" above.
 */
 
-bool BigInt::operator>(const long long& num) const {
-    return *this > BigInt(num);
+void limbs_mul_toom3(u64* result, const u64* num1, size_t size1,
+                     const u64* num2, size_t size2) {
+    size_t piece = (size1 + 2) / 3, width = piece + 1;
+    size_t top1 = toom_piece_size(size1, piece, 2);
+    size_t top2 = toom_piece_size(size2, piece, 2);
+    size_t size = size1 + size2;
+
+    ScratchFrame scratch;
+    u64* values1 = scratch.allocate(3 * width);
+    u64* values2 = scratch.allocate(3 * width);
+    bool negative = toom3_evaluate(values1, num1, size1, piece) !=
+                    toom3_evaluate(values2, num2, size2, piece);
+
+    u64* products = scratch.allocate(3 * 2 * width);
+    for (size_t i = 0; i < 3; i++)
+        limbs_mul(products + 2 * width * i, values1 + width * i, width,
+                  values2 + width * i, width);
+
+    limbs_mul(result, num1, piece, num2, piece);
+    std::fill(result + 2 * piece, result + size, 0);
+    size_t vinf_size = top1 and top2 ? top1 + top2 : 0;
+    if (vinf_size)
+        limbs_mul(result + 4 * piece, num1 + 2 * piece, top1,
+                  num2 + 2 * piece, top2);
+
+    toom3_interpolate(result, size, piece, products, products + 2 * width,
+                      negative, products + 4 * width, vinf_size);
 }
 
 /*
-    Integer > BigInt
-    ----------------
+    limbs_sqr_toom3
+    ---------------
+    Toom-3 squaring, which evaluates the operand once per point and squares
+    the values.
 */
 
-bool operator>(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) > rhs;
+void limbs_sqr_toom3(u64* result, const u64* num, size_t size) {
+    size_t piece = (size + 2) / 3, width = piece + 1;
+    size_t top = toom_piece_size(size, piece, 2);
+
+    ScratchFrame scratch;
+    u64* values = scratch.allocate(3 * width);
+    toom3_evaluate(values, num, size, piece);
+
+    u64* squares = scratch.allocate(3 * 2 * width);
+    for (size_t i = 0; i < 3; i++)
+        limbs_sqr(squares + 2 * width * i, values + width * i, width);
+
+    limbs_sqr(result, num, piece);
+    std::fill(result + 2 * piece, result + 2 * size, 0);
+    if (top) limbs_sqr(result + 4 * piece, num + 2 * piece, top);
+
+    toom3_interpolate(result, 2 * size, piece, squares, squares + 2 * width,
+                      false, squares + 4 * width, 2 * top);
 }
 
 /*
-    BigInt <= Integer
-    -----------------
+    toom4_evaluate
+    --------------
+    Evaluates A(x) for the 4-piece split of a `size`-limb number at 1, -1, 2,
+    -2 and 1/2, writing `piece + 1` limbs each to `values` in that order. The
+    value at 1/2 is scaled by 8 to keep it integral, and those at -1 and -2
+    are written as magnitudes, with their signs stored in `negative`.
 */
 
-bool BigInt::operator<=(const long long& num) const {
-    return !(*this > BigInt(num));
+void toom4_evaluate(u64* values, bool* negative, const u64* num, size_t size,
+                    size_t piece) {
+    size_t width = piece + 1;
+    size_t sizes[4] = {piece, toom_piece_size(size, piece, 1),
+                       toom_piece_size(size, piece, 2),
+                       toom_piece_size(size, piece, 3)};
+    const u64* pieces[4] = {num, num + piece, num + 2 * piece, num + 3 * piece};
+
+    ScratchFrame scratch;
+    u64* even = scratch.allocate(width);
+    u64* odd = scratch.allocate(width);
+
+    // x0 + x2 and x1 + x3
+    even[piece] = limbs_add(even, pieces[0], piece, pieces[2], sizes[2]);
+    toom_load_piece(odd, width, pieces[1], sizes[1]);
+    limbs_add(odd, odd, width, pieces[3], sizes[3]);
+    negative[0] = toom_sum_and_difference(values, values + width, even, odd,
+                                          width);
+
+    // x0 + 4 * x2 and 2 * x1 + 8 * x3
+    toom_load_piece(even, width, pieces[2], sizes[2]);
+    limbs_lshift(even, even, width, 2);
+    limbs_add(even, even, width, pieces[0], piece);
+    toom_load_piece(odd, width, pieces[3], sizes[3]);
+    limbs_lshift(odd, odd, width, 2);
+    limbs_add(odd, odd, width, pieces[1], sizes[1]);
+    limbs_lshift(odd, odd, width, 1);
+    negative[1] = toom_sum_and_difference(values + 2 * width,
+                                          values + 3 * width, even, odd, width);
+
+    // 8 * A(1/2) = ((2 * x0 + x1) * 2 + x2) * 2 + x3
+    u64* at_half = values + 4 * width;
+    toom_load_piece(at_half, width, pieces[0], piece);
+    for (size_t i = 1; i < 4; i++) {
+        limbs_lshift(at_half, at_half, width, 1);
+        limbs_add(at_half, at_half, width, pieces[i], sizes[i]);
+    }
 }
 
 /*
-    Integer <= BigInt
+    toom4_interpolate
     -----------------
+    Recovers the coefficients of C(x) from its values at 1, -1, 2, -2 and 1/2
+    (scaled by 64), each of `2 * piece + 2` limbs, and adds them into
+    `result`, whose `size` limbs already hold C(0) at the bottom, `vinf_size`
+    limbs of C(infinity) at `6 * piece` limbs and zeros in between. The values
+    are overwritten.
 */
 
-bool operator<=(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) <= rhs;
+void toom4_interpolate(u64* result, size_t size, size_t piece, u64* values,
+                       const bool* negative, size_t vinf_size) {
+    size_t width = 2 * piece + 2;
+    u64 *at1 = values, *at_minus1 = values + width;
+    u64 *at2 = values + 2 * width, *at_minus2 = values + 3 * width;
+    u64* at_half = values + 4 * width;
+    const u64* at0 = result;
+    const u64* vinf = result + 6 * piece;
+
+    // subtracts `multiplier` times the `sub_size`-limb `subtrahend` from the
+    // `width`-limb `num`
+    auto submul = [width](u64* num, const u64* subtrahend, size_t sub_size,
+                          u64 multiplier) {
+        u64 borrow = limbs_submul_1(num, subtrahend, sub_size, multiplier);
+        limbs_sub_1(num + sub_size, num + sub_size, width - sub_size, borrow);
+    };
+
+    // at_minus1 = (C(1) - C(-1)) / 2 = c1 + c3 + c5
+    // at1 = (C(1) + C(-1)) / 2 - c0 - c6 = c2 + c4
+    if (negative[0])
+        limbs_add(at_minus1, at1, width, at_minus1, width);
+    else
+        limbs_sub(at_minus1, at1, width, at_minus1, width);
+    limbs_rshift(at_minus1, at_minus1, width, 1);
+    limbs_sub(at1, at1, width, at_minus1, width);
+    limbs_sub(at1, at1, width, at0, 2 * piece);
+    limbs_sub(at1, at1, width, vinf, vinf_size);
+
+    // at_minus2 = (C(2) - C(-2)) / 4 = c1 + 4 * c3 + 16 * c5
+    // at2 = ((C(2) + C(-2)) / 2 - c0 - 64 * c6) / 4 = c2 + 4 * c4
+    if (negative[1])
+        limbs_add(at_minus2, at2, width, at_minus2, width);
+    else
+        limbs_sub(at_minus2, at2, width, at_minus2, width);
+    limbs_rshift(at_minus2, at_minus2, width, 2);
+    limbs_submul_1(at2, at_minus2, width, 2);
+    limbs_sub(at2, at2, width, at0, 2 * piece);
+    submul(at2, vinf, vinf_size, 64);
+    limbs_rshift(at2, at2, width, 2);
+
+    // at2 = (c2 + 4 * c4 - (c2 + c4)) / 3 = c4, at1 = c2
+    limbs_sub(at2, at2, width, at1, width);
+    limbs_divexact_1(at2, width, 3);
+    limbs_sub(at1, at1, width, at2, width);
+
+    // at_half = (64 * C(1/2) - 64 * c0 - 16 * c2 - 4 * c4 - c6) / 2
+    //         = 16 * c1 + 4 * c3 + c5
+    submul(at_half, at0, 2 * piece, 64);
+    limbs_submul_1(at_half, at1, width, 16);
+    limbs_submul_1(at_half, at2, width, 4);
+    limbs_sub(at_half, at_half, width, vinf, vinf_size);
+    limbs_rshift(at_half, at_half, width, 1);
+
+    // C(0) and C(infinity) are no longer needed, so the even coefficients can
+    // be added in, which frees at1 for the odd ones
+    toom_add_coefficient(result, size, 2 * piece, at1, width);
+    toom_add_coefficient(result, size, 4 * piece, at2, width);
+
+    // at_minus2 = ((c1 + 4 * c3 + 16 * c5) - (c1 + c3 + c5)) / 3 = c3 + 5 * c5
+    limbs_sub(at_minus2, at_minus2, width, at_minus1, width);
+    limbs_divexact_1(at_minus2, width, 3);
+
+    // at1 = (16 * (c1 + c3 + c5) - at_half) / 3 = 4 * c3 + 5 * c5
+    limbs_lshift(at1, at_minus1, width, 4);
+    limbs_sub(at1, at1, width, at_half, width);
+    limbs_divexact_1(at1, width, 3);
+
+    // at1 = (4 * c3 + 5 * c5 - (c3 + 5 * c5)) / 3 = c3
+    limbs_sub(at1, at1, width, at_minus2, width);
+    limbs_divexact_1(at1, width, 3);
+
+    // at_minus2 = (c3 + 5 * c5 - c3) / 5 = c5, at_minus1 = c1
+    limbs_sub(at_minus2, at_minus2, width, at1, width);
+    limbs_divexact_1(at_minus2, width, 5);
+    limbs_sub(at_minus1, at_minus1, width, at1, width);
+    limbs_sub(at_minus1, at_minus1, width, at_minus2, width);
+
+    toom_add_coefficient(result, size, piece, at_minus1, width);
+    toom_add_coefficient(result, size, 3 * piece, at1, width);
+    toom_add_coefficient(result, size, 5 * piece, at_minus2, width);
 }
 
 /*
-    BigInt >= Integer
-    -----------------
+    limbs_mul_toom4
+    ---------------
+    Toom-4 multiplication; see "Toom-Cook multiplication" above.
 */
 
-bool BigInt::operator>=(const long long& num) const {
-    return !(*this < BigInt(num));
+void limbs_mul_toom4(u64* result, const u64* num1, size_t size1,
+                     const u64* num2, size_t size2) {
+    size_t piece = (size1 + 3) / 4, width = piece + 1;
+    size_t top1 = toom_piece_size(size1, piece, 3);
+    size_t top2 = toom_piece_size(size2, piece, 3);
+    size_t size = size1 + size2;
+
+    ScratchFrame scratch;
+    u64* values1 = scratch.allocate(5 * width);
+    u64* values2 = scratch.allocate(5 * width);
+    bool negative1[2], negative2[2];
+    toom4_evaluate(values1, negative1, num1, size1, piece);
+    toom4_evaluate(values2, negative2, num2, size2, piece);
+    bool negative[2] = {negative1[0] != negative2[0],
+                        negative1[1] != negative2[1]};
+
+    u64* products = scratch.allocate(5 * 2 * width);
+    for (size_t i = 0; i < 5; i++)
+        limbs_mul(products + 2 * width * i, values1 + width * i, width,
+                  values2 + width * i, width);
+
+    limbs_mul(result, num1, piece, num2, piece);
+    std::fill(result + 2 * piece, result + size, 0);
+    size_t vinf_size = top1 and top2 ? top1 + top2 : 0;
+    if (vinf_size)
+        limbs_mul(result + 6 * piece, num1 + 3 * piece, top1,
+                  num2 + 3 * piece, top2);
+
+    toom4_interpolate(result, size, piece, products, negative, vinf_size);
 }
 
 /*
-    Integer >= BigInt
-    -----------------
+    limbs_sqr_toom4
+    ---------------
+    Toom-4 squaring, which evaluates the operand once per point and squares
+    the values.
 */
 
-bool operator>=(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) >= rhs;
+void limbs_sqr_toom4(u64* result, const u64* num, size_t size) {
+    size_t piece = (size + 3) / 4, width = piece + 1;
+    size_t top = toom_piece_size(size, piece, 3);
+
+    ScratchFrame scratch;
+    u64* values = scratch.allocate(5 * width);
+    bool signs[2];  // the squares are non-negative whatever the signs
+    toom4_evaluate(values, signs, num, size, piece);
+
+    u64* squares = scratch.allocate(5 * 2 * width);
+    for (size_t i = 0; i < 5; i++)
+        limbs_sqr(squares + 2 * width * i, values + width * i, width);
+
+    limbs_sqr(result, num, piece);
+    std::fill(result + 2 * piece, result + 2 * size, 0);
+    if (top) limbs_sqr(result + 6 * piece, num + 3 * piece, top);
+
+    bool negative[2] = {false, false};
+    toom4_interpolate(result, 2 * size, piece, squares, negative, 2 * top);
 }
 
 /*
-    BigInt == String
-    ----------------
+    NTT primes
+    ----------
+    Primes of the form c * 2^k + 1 with primitive root 3, whose product
+    exceeds every coefficient of a convolution of up to 2^22 pairs of 32-bit
+    digits, so that three number-theoretic transforms recover it exactly.
 */
 
-bool BigInt::operator==(const std::string& num) const {
-    return *this == BigInt(num);
-}
+constexpr u32 NTT_PRIME1 = 998244353;  // 7 * 17 * 2^23 + 1
+constexpr u32 NTT_PRIME2 = 167772161;  // 5 * 2^25 + 1
+constexpr u32 NTT_PRIME3 = 469762049;  // 7 * 2^26 + 1
+constexpr u32 NTT_PRIMITIVE_ROOT = 3;
+
+// longest transform that all three primes support
+constexpr size_t NTT_MAX_LENGTH = size_t(1) << 23;
+// largest total operand size, in limbs, whose product fits in a transform
+constexpr size_t NTT_MAX_LIMBS = NTT_MAX_LENGTH / 2;
 
 /*
-    String == BigInt
-    ----------------
+    pow_mod
+    -------
+    Returns base^exp modulo `mod` for word-sized values.
 */
 
-bool operator==(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) == rhs;
+constexpr u32 pow_mod(u64 base, u64 exp, u32 mod) {
+    u64 result = 1;
+    for (base %= mod; exp; exp >>= 1) {
+        if (exp & 1) result = result * base % mod;
+        base = base * base % mod;
+    }
+
+    return result;
 }
 
 /*
-    BigInt != String
-    ----------------
+    ntt_transform
+    -------------
+    In-place number-theoretic transform of a power-of-two length vector modulo
+    the prime `P`. The forward transform (decimation in frequency) leaves its
+    output in bit-reversed order and the inverse transform (decimation in
+    time) takes its input in that order, so no permutation is needed between
+    them for convolutions.
 */
 
-bool BigInt::operator!=(const std::string& num) const {
-    return !(*this == BigInt(num));
+template <u32 P>
+void ntt_transform(std::vector<u32>& values, bool inverse) {
+    size_t length = values.size();
+
+    // the powers of a primitive `block`-th root of unity used by the
+    // butterflies on blocks of that size start at `roots[block / 2]`
+    std::vector<u32> roots(std::max(length, size_t(2)));
+    u32 root = pow_mod(NTT_PRIMITIVE_ROOT, (P - 1) / length, P);
+    if (inverse) root = pow_mod(root, P - 2, P);
+    u64 power = 1;
+    for (size_t j = length / 2; j < length; j++) {
+        roots[j] = power;
+        power = power * root % P;
+    }
+    for (size_t j = length / 2; j-- > 1;) roots[j] = roots[2 * j];
+
+    auto butterfly = [&](size_t block, bool decimate_in_frequency) {
+        size_t half = block / 2;
+        const u32* block_roots = roots.data() + half;
+        for (size_t i = 0; i < length; i += block)
+            for (size_t j = 0; j < half; j++) {
+                u32& low = values[i + j];
+                u32& high = values[i + j + half];
+                u64 w = block_roots[j];
+                if (decimate_in_frequency) {
+                    u32 sum = low + high >= P ? low + high - P : low + high;
+                    u32 difference = low >= high ? low - high : low + P - high;
+                    low = sum;
+                    high = difference * w % P;
+                } else {
+                    u32 twiddled = high * w % P;
+                    u32 sum = low + twiddled >= P ? low + twiddled - P
+                                                  : low + twiddled;
+                    high = low >= twiddled ? low - twiddled
+                                           : low + P - twiddled;
+                    low = sum;
+                }
+            }
+    };
+
+    if (!inverse)
+        for (size_t block = length; block >= 2; block /= 2)
+            butterfly(block, true);
+    else {
+        for (size_t block = 2; block <= length; block *= 2)
+            butterfly(block, false);
+
+        u64 length_inverse = pow_mod(length, P - 2, P);
+        for (u32& value : values) value = value * length_inverse % P;
+    }
 }
 
 /*
-    String != BigInt
-    ----------------
+    ntt_convolve
+    ------------
+    Returns the cyclic convolution modulo `P` of two digit vectors, padded to
+    `length` digits. Convolving a vector with itself takes a single forward
+    transform.
 */
 
-bool operator!=(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) != rhs;
+template <u32 P>
+std::vector<u32> ntt_convolve(const std::vector<u32>& digits1,
+                              const std::vector<u32>& digits2, size_t length) {
+    bool squaring = &digits1 == &digits2;
+
+    std::vector<u32> transform1(length), transform2;
+    for (size_t i = 0; i < digits1.size(); i++) transform1[i] = digits1[i] % P;
+    ntt_transform<P>(transform1, false);
+
+    if (squaring)
+        for (size_t i = 0; i < length; i++)
+            transform1[i] = (u64)transform1[i] * transform1[i] % P;
+    else {
+        transform2.resize(length);
+        for (size_t i = 0; i < digits2.size(); i++)
+            transform2[i] = digits2[i] % P;
+        ntt_transform<P>(transform2, false);
+
+        for (size_t i = 0; i < length; i++)
+            transform1[i] = (u64)transform1[i] * transform2[i] % P;
+    }
+    ntt_transform<P>(transform1, true);
+
+    return transform1;
 }
 
 /*
-    BigInt < String
-    ---------------
+    limbs_to_digits32
+    -----------------
+    Splits a limb buffer into 32-bit digits, least significant first.
 */
 
-bool BigInt::operator<(const std::string& num) const {
-    return *this < BigInt(num);
+std::vector<u32> limbs_to_digits32(const u64* num, size_t size) {
+    std::vector<u32> digits(2 * size);
+    for (size_t i = 0; i < size; i++) {
+        digits[2 * i] = (u32)num[i];
+        digits[2 * i + 1] = (u32)(num[i] >> 32);
+    }
+
+    return digits;
 }
 
 /*
-    String < BigInt
-    ---------------
+    limbs_mul_ntt
+    -------------
+    Multiplies two numbers by convolving their 32-bit digits modulo three NTT
+    primes and recombining each coefficient with the Chinese remainder
+    theorem (Garner's algorithm), carrying the coefficients into the product.
+    NOTE: `size1 + size2` must not exceed NTT_MAX_LIMBS.
 */
 
-bool operator<(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) < rhs;
+void limbs_mul_ntt(u64* result, const u64* num1, size_t size1,
+                   const u64* num2, size_t size2) {
+    bool squaring = num1 == num2 and size1 == size2;
+    std::vector<u32> digits1 = limbs_to_digits32(num1, size1);
+    std::vector<u32> digits2;
+    if (!squaring) digits2 = limbs_to_digits32(num2, size2);
+    const std::vector<u32>& operand2 = squaring ? digits1 : digits2;
+
+    size_t num_digits = 2 * (size1 + size2);
+    size_t length = 1;
+    while (length < num_digits - 1) length *= 2;
+
+    std::vector<u32> residues1 =
+        ntt_convolve<NTT_PRIME1>(digits1, operand2, length);
+    std::vector<u32> residues2 =
+        ntt_convolve<NTT_PRIME2>(digits1, operand2, length);
+    std::vector<u32> residues3 =
+        ntt_convolve<NTT_PRIME3>(digits1, operand2, length);
+
+    constexpr u64 prime12 = (u64)NTT_PRIME1 * NTT_PRIME2;
+    constexpr u64 prime1_inverse = pow_mod(NTT_PRIME1, NTT_PRIME2 - 2,
+                                           NTT_PRIME2);  // mod NTT_PRIME2
+    constexpr u64 prime12_inverse = pow_mod(prime12, NTT_PRIME3 - 2,
+                                            NTT_PRIME3);  // mod NTT_PRIME3
+
+    u128 carry = 0;
+    for (size_t i = 0; i < num_digits; i++) {
+        u64 residue1 = i < length ? residues1[i] : 0;
+        u64 residue2 = i < length ? residues2[i] : 0;
+        u64 residue3 = i < length ? residues3[i] : 0;
+
+        // x = residue1 + NTT_PRIME1 * t2 + NTT_PRIME1 * NTT_PRIME2 * t3
+        u64 t2 = (residue2 + NTT_PRIME2 - residue1 % NTT_PRIME2) *
+                 prime1_inverse % NTT_PRIME2;
+        u64 x12 = residue1 + NTT_PRIME1 * t2;
+        u64 t3 = (residue3 + NTT_PRIME3 - x12 % NTT_PRIME3) * prime12_inverse %
+                 NTT_PRIME3;
+
+        carry += x12 + (u128)prime12 * t3;
+        u32 digit = (u32)carry;
+        carry >>= 32;
+
+        if (i % 2 == 0)
+            result[i / 2] = digit;
+        else
+            result[i / 2] |= (u64)digit << 32;
+    }
 }
 
 /*
-    BigInt > String
-    ---------------
+    limbs_mul
+    ---------
+    Multiplies two numbers of `size1` and `size2` limbs, writing the
+    `size1 + size2` limbs of the product to `result`. Operands much longer than
+    the other are multiplied in blocks the size of the shorter one, and
+    roughly balanced operands by the algorithm suited to their size. Products
+    too long for a single NTT fall back to Toom-4, whose pieces are then
+    multiplied with NTTs.
+    NOTE: `result` must not overlap either operand.
 */
 
-bool BigInt::operator>(const std::string& num) const {
-    return *this > BigInt(num);
-}
+void limbs_mul(u64* result, const u64* num1, size_t size1, const u64* num2,
+               size_t size2) {
+    if (num1 == num2 and size1 == size2) return limbs_sqr(result, num1, size1);
 
-/*
-    String > BigInt
-    ---------------
-*/
+    if (size1 < size2) {
+        std::swap(num1, num2);
+        std::swap(size1, size2);
+    }
 
-bool operator>(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) > rhs;
+    if (size2 == 0)
+        std::fill(result, result + size1, 0);
+    else if (size2 < NUMERICXX_BIGINT_KARATSUBA_THRESHOLD)
+        limbs_mul_basecase(result, num1, size1, num2, size2);
+    else if (2 * size2 <= size1) {
+        std::fill(result, result + size1 + size2, 0);
+        ScratchFrame scratch;
+        u64* block_product = scratch.allocate(2 * size2);
+        for (size_t i = 0; i < size1; i += size2) {
+            size_t block_size = std::min(size2, size1 - i);
+            limbs_mul(block_product, num1 + i, block_size, num2, size2);
+            limbs_add(result + i, result + i, size1 + size2 - i, block_product,
+                      block_size + size2);
+        }
+    } else if (size2 >= NUMERICXX_BIGINT_NTT_THRESHOLD and
+               size1 + size2 <= NTT_MAX_LIMBS)
+        limbs_mul_ntt(result, num1, size1, num2, size2);
+    else if (size2 < NUMERICXX_BIGINT_TOOM3_THRESHOLD)
+        limbs_mul_karatsuba(result, num1, size1, num2, size2);
+    else if (size2 < NUMERICXX_BIGINT_TOOM4_THRESHOLD)
+        limbs_mul_toom3(result, num1, size1, num2, size2);
+    else
+        limbs_mul_toom4(result, num1, size1, num2, size2);
 }
 
 /*
-    BigInt <= String
-    ----------------
+    limbs_sqr
+    ---------
+    Squares a number of `size` limbs, writing the `2 * size` limbs of the
+    square to `result`, with the squaring variant of the algorithm that
+    `limbs_mul` would use for the same operands.
+    NOTE: `result` must not overlap `num`.
 */
 
-bool BigInt::operator<=(const std::string& num) const {
-    return !(*this > BigInt(num));
+void limbs_sqr(u64* result, const u64* num, size_t size) {
+    if (size == 0)
+        return;
+    else if (size < NUMERICXX_BIGINT_KARATSUBA_THRESHOLD)
+        limbs_sqr_basecase(result, num, size);
+    else if (size >= NUMERICXX_BIGINT_NTT_THRESHOLD and
+             2 * size <= NTT_MAX_LIMBS)
+        limbs_mul_ntt(result, num, size, num, size);
+    else if (size < NUMERICXX_BIGINT_TOOM3_THRESHOLD)
+        limbs_sqr_karatsuba(result, num, size);
+    else if (size < NUMERICXX_BIGINT_TOOM4_THRESHOLD)
+        limbs_sqr_toom3(result, num, size);
+    else
+        limbs_sqr_toom4(result, num, size);
 }
 
 /*
-    String <= BigInt
-    ----------------
+    multiply_magnitudes
+    -------------------
+    Returns the product of two magnitudes.
 */
 
-bool operator<=(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) <= rhs;
-}
+LimbVector multiply_magnitudes(const LimbVector& num1, const LimbVector& num2) {
+    LimbVector product;
+    if (num1.empty() or num2.empty()) return product;
 
-/*
-    BigInt >= String
-    ----------------
-*/
+    product.resize(num1.size() + num2.size());
+    limbs_mul(product.data(), num1.data(), num1.size(), num2.data(),
+              num2.size());
+    strip_leading_zero_limbs(product);
 
-bool BigInt::operator>=(const std::string& num) const {
-    return !(*this < BigInt(num));
+    return product;
 }
 
 /*
-    String >= BigInt
+    square_magnitude
     ----------------
+    Returns the square of a magnitude.
 */
 
-bool operator>=(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) >= rhs;
+LimbVector square_magnitude(const LimbVector& num) {
+    LimbVector square;
+    if (num.empty()) return square;
+
+    square.resize(2 * num.size());
+    limbs_sqr(square.data(), num.data(), num.size());
+    strip_leading_zero_limbs(square);
+
+    return square;
 }
 
-#endif  // BIG_INT_RELATIONAL_OPERATORS_HPP
+}  // namespace numericxx::detail
+
+#endif  // BIG_INT_MULTIPLICATION_HPP
 
 /*
     ===========================================================================
-    Math functions for BigInt
+    Division algorithms
     ===========================================================================
+    Division of limb buffers: Knuth's long division for small operands,
+    Burnikel-Ziegler recursive division above it, and multiplication by a
+    Newton reciprocal for the largest ones.
 */
 
-#ifndef BIG_INT_MATH_FUNCTIONS_HPP
-#define BIG_INT_MATH_FUNCTIONS_HPP
+#ifndef BIG_INT_DIVISION_HPP
+#define BIG_INT_DIVISION_HPP
 
-#include <string>
+namespace numericxx::detail {
+
+void limbs_div_3n_2n(u64*, u64*, const u64*, const u64*, size_t);
 
 /*
-    abs
-    ---
-    Returns the absolute value of a BigInt.
+    limbs_divrem_knuth
+    ------------------
+    Knuth's Algorithm D (TAOCP vol. 2, 4.3.1). The divisor is normalised so
+    that its top bit is set, which lets each quotient limb be estimated from
+    the top two limbs of the running remainder and the top limb of the
+    divisor, then corrected using the second limb of the divisor. The estimate
+    is then at most one too large, which the multiply-and-subtract step
+    detects and undoes by adding the divisor back.
+    Writes the `size1 - size2 + 1` quotient limbs to `quotient` and the
+    `size2` remainder limbs to `remainder`.
+    NOTE: expects `size1 >= size2 >= 2` and a non-zero top divisor limb.
 */
 
-BigInt abs(const BigInt& num) { return num < 0 ? -num : num; }
+void limbs_divrem_knuth(u64* quotient, u64* remainder, const u64* dividend,
+                        size_t size1, const u64* divisor, size_t size2) {
+    unsigned shift = __builtin_clzll(divisor[size2 - 1]);
+
+    ScratchFrame scratch;
+    u64* d = scratch.allocate(size2);
+    u64* u = scratch.allocate(size1 + 1);
+    limbs_lshift(d, divisor, size2, shift);
+    u[size1] = limbs_lshift(u, dividend, size1, shift);
+
+    u64 d_high = d[size2 - 1], d_next = d[size2 - 2];
+
+    for (size_t j = size1 - size2 + 1; j-- > 0;) {
+        // estimate the quotient limb from the top of the running remainder
+        u128 numerator = ((u128)u[j + size2] << 64) | u[j + size2 - 1];
+        u128 q_estimate = numerator / d_high;
+        u128 r_estimate = numerator % d_high;
+        if (q_estimate > U64_MAX) {
+            q_estimate = U64_MAX;
+            r_estimate = numerator - q_estimate * d_high;
+        }
+        while (r_estimate <= U64_MAX and
+               q_estimate * d_next >
+                   ((r_estimate << 64) | u[j + size2 - 2])) {
+            q_estimate--;
+            r_estimate += d_high;
+        }
+
+        // subtract q_estimate * divisor, adding it back if that went negative
+        u64 q_limb = (u64)q_estimate;
+        u64 borrow = limbs_submul_1(u + j, d, size2, q_limb);
+        bool negative = u[j + size2] < borrow;
+        u[j + size2] -= borrow;
+        if (negative) {
+            q_limb--;
+            u[j + size2] += limbs_add(u + j, u + j, size2, d, size2);
+        }
+
+        quotient[j] = q_limb;
+    }
+
+    limbs_rshift(remainder, u, size2, shift);
+}
 
 /*
-    big_pow10
-    ---------
-    Returns a BigInt equal to 10^exp.
-    NOTE: exponent should be a non-negative integer.
+    limbs_div_2n_1n
+    ---------------
+    Burnikel-Ziegler recursive division of the 2n-limb number `num` by the
+    normalised n-limb divisor `divisor`, where num < divisor * B^n. Writes the
+    n quotient limbs to `quotient` and the n remainder limbs to `remainder`.
+    Each half of the quotient comes from a 3n/2n division, which in turn
+    divides by the top half of the divisor with a 2n/1n division, so the cost
+    is that of a few multiplications per level of recursion.
 */
 
-BigInt big_pow10(size_t exp) { return BigInt("1" + std::string(exp, '0')); }
+void limbs_div_2n_1n(u64* quotient, u64* remainder, const u64* num,
+                     const u64* divisor, size_t n) {
+    if (n == 1) {
+        u128 numerator = ((u128)num[1] << 64) | num[0];
+        quotient[0] = (u64)(numerator / divisor[0]);
+        remainder[0] = (u64)(numerator % divisor[0]);
+        return;
+    }
+    if (n % 2 or n < NUMERICXX_BIGINT_BZ_THRESHOLD) {
+        ScratchFrame scratch;
+        u64* long_quotient = scratch.allocate(n + 1);  // top limb is always 0
+        limbs_divrem_knuth(long_quotient, remainder, num, 2 * n, divisor, n);
+        std::copy(long_quotient, long_quotient + n, quotient);
+        return;
+    }
+
+    size_t half = n / 2;
+    ScratchFrame scratch;
+    u64* partial = scratch.allocate(n + half);  // [first remainder, num_low]
+    limbs_div_3n_2n(quotient + half, partial + half, num + half, divisor, half);
+    std::copy(num, num + half, partial);
+    limbs_div_3n_2n(quotient, remainder, partial, divisor, half);
+}
 
 /*
-    pow (BigInt)
-    ------------
-    Returns a BigInt equal to base^exp.
+    limbs_div_3n_2n
+    ---------------
+    Divides the 3h-limb number `num` by the normalised 2h-limb divisor, where
+    num < divisor * B^h, writing h quotient limbs and 2h remainder limbs. The
+    quotient is estimated by dividing the top 2h limbs of `num` by the top h
+    limbs of the divisor, and is then at most two too large.
 */
 
-BigInt pow(const BigInt& base, int exp) {
-    if (exp < 0) {
-        if (base == 0) throw std::logic_error("Cannot divide by zero");
-        return abs(base) == 1 ? base : 0;
-    }
-    if (exp == 0) {
-        if (base == 0) throw std::logic_error("Zero cannot be raised to zero");
-        return 1;
+void limbs_div_3n_2n(u64* quotient, u64* remainder, const u64* num,
+                     const u64* divisor, size_t h) {
+    const u64* divisor_high = divisor + h;
+
+    // partial = [remainder of the estimate, num_low], with room for a carry
+    ScratchFrame scratch;
+    u64* partial = scratch.allocate(2 * h + 1);
+    std::copy(num, num + h, partial);
+    partial[2 * h] = 0;
+    if (limbs_cmp(num + 2 * h, h, divisor_high, h) < 0)
+        limbs_div_2n_1n(quotient, partial + h, num + h, divisor_high, h);
+    else {
+        // the estimate is B^h - 1, leaving num_high - (B^h - 1) * divisor_high
+        std::fill(quotient, quotient + h, U64_MAX);
+        u64* estimate_remainder = scratch.allocate(2 * h + 1);
+        std::copy(num + h, num + 3 * h, estimate_remainder);
+        estimate_remainder[2 * h] = 0;
+        limbs_sub(estimate_remainder + h, estimate_remainder + h, h + 1,
+                  divisor_high, h);
+        limbs_add(estimate_remainder, estimate_remainder, 2 * h + 1,
+                  divisor_high, h);
+        std::copy(estimate_remainder, estimate_remainder + h + 1, partial + h);
     }
 
-    BigInt result = base, result_odd = 1;
-    while (exp > 1) {
-        if (exp % 2) result_odd *= result;
-        result *= result;
-        exp /= 2;
+    // subtract quotient * divisor_low, correcting the quotient while the
+    // remainder is negative
+    u64* product = scratch.allocate(2 * h);
+    limbs_mul(product, quotient, h, divisor, h);
+    if (limbs_cmp(partial, 2 * h + 1, product, 2 * h) >= 0) {
+        limbs_sub(partial, partial, 2 * h + 1, product, 2 * h);
+        std::copy(partial, partial + 2 * h, remainder);
+        return;
     }
 
-    return result * result_odd;
+    const u64 one = 1;
+    u64* deficit = product;  // product - partial, as partial < product
+    limbs_sub(deficit, product, 2 * h, partial, 2 * h);
+    while (true) {
+        limbs_sub(quotient, quotient, h, &one, 1);
+        if (limbs_cmp(deficit, 2 * h, divisor, 2 * h) <= 0) {
+            limbs_sub(remainder, divisor, 2 * h, deficit, 2 * h);
+            return;
+        }
+        limbs_sub(deficit, deficit, 2 * h, divisor, 2 * h);
+    }
 }
 
 /*
-    pow (Integer)
-    -------------
-    Returns a BigInt equal to base^exp.
+    shift_limbs_down
+    ----------------
+    Divides a magnitude by B^num_limbs, discarding the remainder.
 */
 
-BigInt pow(const long long& base, int exp) { return pow(BigInt(base), exp); }
+void shift_limbs_down(LimbVector& num, size_t num_limbs) {
+    if (num.size() <= num_limbs) {
+        num.clear();
+        return;
+    }
+
+    std::copy(num.begin() + num_limbs, num.end(), num.begin());
+    num.resize(num.size() - num_limbs);
+}
 
 /*
-    pow (String)
-    ------------
-    Returns a BigInt equal to base^exp.
+    shift_limbs_up
+    --------------
+    Multiplies a magnitude by B^num_limbs.
 */
 
-BigInt pow(const std::string& base, int exp) { return pow(BigInt(base), exp); }
+void shift_limbs_up(LimbVector& num, size_t num_limbs) {
+    if (num.empty()) return;
+
+    num.resize(num.size() + num_limbs);
+    std::copy_backward(num.begin(), num.end() - num_limbs, num.end());
+    std::fill(num.begin(), num.begin() + num_limbs, 0);
+}
 
 /*
-    sqrt
-    ----
-    Returns the positive integer square root of a BigInt using Newton's method.
-    NOTE: the input must be non-negative.
+    limbs_reciprocal
+    ----------------
+    Writes the n + 1 limbs of floor(B^(2n) / num) for a normalised n-limb
+    number, by Newton's iteration x' = x + x * (B^(2n) - num * x) / B^(2n).
+    The starting value is the reciprocal of the top half of `num`, which is
+    accurate to about half the limbs, and a single step roughly doubles that
+    accuracy; the few units of error left are then corrected exactly.
+    NOTE: `result` must not overlap `num`.
 */
 
-BigInt sqrt(const BigInt& num) {
-    if (num < 0)
-        throw std::invalid_argument(
-            "Cannot compute square root of a negative integer");
+void limbs_reciprocal(u64* result, const u64* num, size_t n) {
+    ScratchFrame scratch;
+    if (n < NUMERICXX_BIGINT_BZ_THRESHOLD or n == 1) {
+        u64* power = scratch.allocate(2 * n + 1);
+        u64* quotient = scratch.allocate(2 * n + 1);
+        std::fill(power, power + 2 * n, 0);
+        power[2 * n] = 1;
+        if (n == 1)
+            limbs_divrem_1(quotient, power, 3, LimbDivisor(num[0]));
+        else
+            limbs_divrem_knuth(quotient, scratch.allocate(n), power, 2 * n + 1,
+                               num, n);
+        std::copy(quotient, quotient + n + 1, result);
+        return;
+    }
 
-    // Optimisations for small inputs:
-    if (num == 0)
-        return 0;
-    else if (num < 4)
-        return 1;
-    else if (num < 9)
-        return 2;
-    else if (num < 16)
-        return 3;
+    // with X the reciprocal of the top half, the starting value is X * B^low
+    // and its error term B^(2n) - num * X * B^low is E * B^low, where
+    // E = B^(n+high) - num * X lies in (-2 * B^n, B^n)
+    size_t high = (n + 1) / 2, low = n - high;
+    u64* half_reciprocal = scratch.allocate(high + 1);
+    limbs_reciprocal(half_reciprocal, num + low, high);
+    u64* error = scratch.allocate(n + high + 1);
+    limbs_mul(error, num, n, half_reciprocal, high + 1);
+    // num * X is within 2 * B^n of B^(n+high), so its top limb is 1 if E is
+    // negative and 0 otherwise, and |E| is left in the low n + 1 limbs
+    bool negative = error[n + high] != 0;
+    if (negative)
+        error[n + high]--;
+    else
+        limbs_negate(error, n + high);
 
-    BigInt sqrt_prev = -1;
-    // The value for `sqrt_current` is chosen close to that of the actual
-    // square root.
-    // Since a number's square root has at least one less than half as many
-    // digits as the number,
-    //     sqrt_current = 10^(half_the_digits_in_num - 1)
-    BigInt sqrt_current = big_pow10(num.to_string().size() / 2 - 1);
+    u64* product = scratch.allocate(n + high + 2);
+    limbs_mul(product, half_reciprocal, high + 1, error, n + 1);
+    const u64* step = product + 2 * high;  // below 4 * B^low
 
-    while (abs(sqrt_current - sqrt_prev) > 1) {
-        sqrt_prev = sqrt_current;
-        sqrt_current = (num / sqrt_prev + sqrt_prev) / 2;
+    std::fill(result, result + low, 0);
+    std::copy(half_reciprocal, half_reciprocal + high + 1, result + low);
+    if (negative)
+        limbs_sub(result, result, n + 1, step, low + 1);
+    else
+        limbs_add(result, result, n + 1, step, low + 1);
+
+    // make B^(2n) - num * result lie in [0, num), with the remainder held in
+    // two's complement since it can be negative
+    size_t width = n + low + 2;
+    u64* remainder = scratch.allocate(width);
+    std::fill(remainder, remainder + low, 0);
+    std::copy(error, error + n + 1, remainder + low);
+    remainder[width - 1] = 0;
+    u64* multiple = scratch.allocate(n + low + 1);
+    limbs_mul(multiple, num, n, step, low + 1);
+    if (negative) {
+        limbs_negate(remainder, width);
+        limbs_add(remainder, remainder, width, multiple, n + low + 1);
+    } else {
+        limbs_sub(remainder, remainder, width, multiple, n + low + 1);
+    }
+    while (remainder[width - 1] >> 63) {
+        limbs_sub_1(result, result, n + 1, 1);
+        limbs_add(remainder, remainder, width, num, n);
+    }
+    while (limbs_cmp(remainder, width, num, n) >= 0) {
+        limbs_add_1(result, result, n + 1, 1);
+        limbs_sub(remainder, remainder, width, num, n);
     }
-
-    return sqrt_current;
 }
 
-#endif  // BIG_INT_MATH_FUNCTIONS_HPP
-
 /*
-    ===========================================================================
-    Binary arithmetic operators
-    ===========================================================================
+    limbs_div_2n_1n_newton
+    ----------------------
+    Divides the 2n-limb number `num` by the normalised n-limb divisor, where
+    num < divisor * B^n, using the n + 1 limbs of the divisor's precomputed
+    reciprocal floor(B^(2n) / divisor). The quotient estimate
+        floor(floor(num / B^(n-1)) * reciprocal / B^(n+1))
+    is never too large and at most three too small.
 */
 
-#ifndef BIG_INT_BINARY_ARITHMETIC_OPERATORS_HPP
-#define BIG_INT_BINARY_ARITHMETIC_OPERATORS_HPP
-
-#include <climits>
-#include <cmath>
-#include <string>
+void limbs_div_2n_1n_newton(u64* quotient, u64* remainder, const u64* num,
+                            const u64* divisor, size_t n,
+                            const u64* reciprocal) {
+    // the top block of a dividend is often short, so leading zero limbs are
+    // left out of both products
+    size_t top_size = n + 1;
+    while (top_size > 0 and num[n + top_size - 2] == 0) top_size--;
+
+    ScratchFrame scratch;
+    u64* product = scratch.allocate(2 * n + 2);
+    limbs_mul(product, num + n - 1, top_size, reciprocal, n + 1);
+    std::fill(quotient, quotient + n, 0);
+    if (top_size > 0)
+        std::copy(product + n + 1, product + std::min(top_size, n) + n + 1,
+                  quotient);
+
+    // the difference is below 4 * divisor, so it fits in n + 1 limbs
+    size_t quotient_size = n;
+    while (quotient_size > 0 and quotient[quotient_size - 1] == 0)
+        quotient_size--;
+    u64* partial = scratch.allocate(2 * n);
+    limbs_mul(partial, quotient, quotient_size, divisor, n);
+    std::fill(partial + quotient_size + n, partial + 2 * n, 0);
+    limbs_sub(partial, num, 2 * n, partial, 2 * n);
+    while (limbs_cmp(partial, n + 1, divisor, n) >= 0) {
+        limbs_sub(partial, partial, n + 1, divisor, n);
+        limbs_add_1(quotient, quotient, n, 1);
+    }
 
-constexpr long long FLOOR_SQRT_LLONG_MAX = 3037000499;
+    std::copy(partial, partial + n, remainder);
+}
 
 /*
-    BigInt + BigInt
-    ---------------
-    The operand on the RHS of the addition is `num`.
+    limbs_divrem_blockwise
+    ----------------------
+    Divides by shifting the divisor up to exactly `n` limbs with its top bit
+    set, then running long division on blocks of n limbs of the equally
+    shifted dividend, each step dividing a 2n-limb window with
+    `divide_block`. Writes `size1 - size2 + 1` quotient limbs and `size2`
+    remainder limbs.
 */
 
-BigInt BigInt::operator+(const BigInt& num) const {
-    // if the operands are of opposite signs, perform subtraction
-    if (this->sign == '+' and num.sign == '-') {
-        BigInt rhs = num;
-        rhs.sign = '+';
-        return *this - rhs;
-    } else if (this->sign == '-' and num.sign == '+') {
-        BigInt lhs = *this;
-        lhs.sign = '+';
-        return -(lhs - num);
+template <class DivideBlock>
+void limbs_divrem_blockwise(u64* quotient, u64* remainder, const u64* dividend,
+                            size_t size1, const u64* divisor, size_t size2,
+                            size_t n, DivideBlock divide_block) {
+    size_t limb_shift = n - size2;
+    unsigned bit_shift = __builtin_clzll(divisor[size2 - 1]);
+
+    ScratchFrame scratch;
+    u64* normalized_divisor = scratch.allocate(n);
+    std::fill(normalized_divisor, normalized_divisor + limb_shift, 0);
+    limbs_lshift(normalized_divisor + limb_shift, divisor, size2, bit_shift);
+
+    // split the dividend into t blocks, leaving the top bit of the top block
+    // clear so that it is less than the divisor; rounding up to whole blocks
+    // adds at most 2n limbs
+    size_t size = size1 + limb_shift + 1;
+    u64* blocks = scratch.allocate(size + 2 * n);
+    std::fill(blocks, blocks + size + 2 * n, 0);
+    blocks[size - 1] =
+        limbs_lshift(blocks + limb_shift, dividend, size1, bit_shift);
+    while (blocks[size - 1] == 0) size--;
+    size_t bits = 64 * size - __builtin_clzll(blocks[size - 1]);
+    size_t t = std::max(size_t(2), bits / (64 * n) + 1);
+
+    u64* block_quotients = scratch.allocate((t - 1) * n);
+    u64* window = scratch.allocate(2 * n);
+    u64* block_remainder = scratch.allocate(n);
+    std::copy(blocks + (t - 2) * n, blocks + t * n, window);
+    for (size_t i = t - 1; i-- > 0;) {
+        divide_block(block_quotients + i * n, block_remainder, window,
+                     normalized_divisor, n);
+        if (i > 0) {
+            std::copy(blocks + (i - 1) * n, blocks + i * n, window);
+            std::copy(block_remainder, block_remainder + n, window + n);
+        }
     }
 
-    // identify the numbers as `larger` and `smaller`
-    std::string larger, smaller;
-    std::tie(larger, smaller) = get_larger_and_smaller(this->value, num.value);
+    size_t quotient_size = size1 - size2 + 1;
+    std::fill(quotient, quotient + quotient_size, 0);
+    std::copy(block_quotients,
+              block_quotients + std::min(quotient_size, (t - 1) * n),
+              quotient);
+    limbs_rshift(remainder, block_remainder + limb_shift, size2, bit_shift);
+}
 
-    BigInt result;      // the resultant sum
-    result.value = "";  // the value is cleared as the digits will be appended
-    short carry = 0, sum;
-    // add the two values
-    for (long i = larger.size() - 1; i >= 0; i--) {
-        sum = larger[i] - '0' + smaller[i] - '0' + carry;
-        result.value = std::to_string(sum % 10) + result.value;
-        carry = sum / (short)10;
-    }
-    if (carry) result.value = std::to_string(carry) + result.value;
+/*
+    limbs_divrem_bz
+    ---------------
+    Burnikel-Ziegler division. The block size is the divisor size rounded up
+    to j * 2^k with j below the threshold, so that the recursion halves it
+    evenly down to Knuth's algorithm.
+*/
 
-    // if the operands are negative, the result is negative
-    if (this->sign == '-' and result.value != "0") result.sign = '-';
+void limbs_divrem_bz(u64* quotient, u64* remainder, const u64* dividend,
+                     size_t size1, const u64* divisor, size_t size2) {
+    size_t levels = 0;
+    while (((size2 - 1) >> levels) + 1 >= NUMERICXX_BIGINT_BZ_THRESHOLD)
+        levels++;
+    size_t n = (((size2 - 1) >> levels) + 1) << levels;
 
-    return result;
+    limbs_divrem_blockwise(quotient, remainder, dividend, size1, divisor, size2,
+                           n, limbs_div_2n_1n);
 }
 
 /*
-    BigInt - BigInt
-    ---------------
-    The operand on the RHS of the subtraction is `num`.
+    limbs_divrem_newton
+    -------------------
+    Division by multiplication with the reciprocal of the divisor, computed
+    once by Newton's iteration and reused for every block of the dividend.
 */
 
-BigInt BigInt::operator-(const BigInt& num) const {
-    // if the operands are of opposite signs, perform addition
-    if (this->sign == '+' and num.sign == '-') {
-        BigInt rhs = num;
-        rhs.sign = '+';
-        return *this + rhs;
-    } else if (this->sign == '-' and num.sign == '+') {
-        BigInt lhs = *this;
-        lhs.sign = '+';
-        return -(lhs + num);
-    }
+void limbs_divrem_newton(u64* quotient, u64* remainder, const u64* dividend,
+                         size_t size1, const u64* divisor, size_t size2) {
+    // the blocks are size2 limbs, and the reciprocal of the normalised
+    // divisor is computed by the first of them and reused by the rest
+    ScratchFrame scratch;
+    u64* reciprocal = scratch.allocate(size2 + 1);
+    bool have_reciprocal = false;
+    auto divide_block = [&](u64* block_quotient, u64* block_remainder,
+                            const u64* num, const u64* normalized_divisor,
+                            size_t n) {
+        if (not have_reciprocal) {
+            limbs_reciprocal(reciprocal, normalized_divisor, n);
+            have_reciprocal = true;
+        }
+        limbs_div_2n_1n_newton(block_quotient, block_remainder, num,
+                               normalized_divisor, n, reciprocal);
+    };
 
-    BigInt result;  // the resultant difference
-    // identify the numbers as `larger` and `smaller`
-    std::string larger, smaller;
-    if (abs(*this) > abs(num)) {
-        larger = this->value;
-        smaller = num.value;
-
-        if (this->sign == '-')  // -larger - -smaller = -result
-            result.sign = '-';
+    limbs_divrem_blockwise(quotient, remainder, dividend, size1, divisor, size2,
+                           size2, divide_block);
+}
+
+/*
+    divide_magnitudes
+    -----------------
+    Returns the quotient and remainder on dividing two magnitudes.
+    NOTE: the divisor must be non-zero.
+*/
+
+std::tuple<LimbVector, LimbVector> divide_magnitudes(
+    const LimbVector& dividend, const LimbVector& divisor) {
+    LimbVector quotient, remainder;
+    if (compare_magnitudes(dividend, divisor) < 0) {
+        remainder = dividend;
+    } else if (divisor.size() == 1) {
+        u64 limb_remainder;
+        std::tie(quotient, limb_remainder) =
+            divide_magnitude_by_limb(dividend, divisor[0]);
+        if (limb_remainder) remainder.push_back(limb_remainder);
     } else {
-        larger = num.value;
-        smaller = this->value;
-
-        if (num.sign == '+')  // smaller - larger = -result
-            result.sign = '-';
-    }
-    // pad the smaller number with zeroes
-    add_leading_zeroes(smaller, larger.size() - smaller.size());
-
-    result.value = "";  // the value is cleared as the digits will be appended
-    short difference;
-    long i, j;
-    // subtract the two values
-    for (i = larger.size() - 1; i >= 0; i--) {
-        difference = larger[i] - smaller[i];
-        if (difference < 0) {
-            for (j = i - 1; j >= 0; j--) {
-                if (larger[j] != '0') {
-                    larger[j]--;  // borrow from the j-th digit
-                    break;
-                }
-            }
-            j++;
-            while (j != i) {
-                larger[j] = '9';  // add the borrow and take away 1
-                j++;
-            }
-            difference += 10;  // add the borrow
-        }
-        result.value = std::to_string(difference) + result.value;
+        // the quotient size bounds the work as much as the divisor size
+        size_t size1 = dividend.size(), size2 = divisor.size();
+        size_t size = std::min(size2, size1 - size2 + 1);
+        quotient.resize(size1 - size2 + 1);
+        remainder.resize(size2);
+        if (size < NUMERICXX_BIGINT_BZ_THRESHOLD)
+            limbs_divrem_knuth(quotient.data(), remainder.data(),
+                               dividend.data(), size1, divisor.data(), size2);
+        else if (size < NUMERICXX_BIGINT_NEWTON_DIV_THRESHOLD)
+            limbs_divrem_bz(quotient.data(), remainder.data(), dividend.data(),
+                            size1, divisor.data(), size2);
+        else
+            limbs_divrem_newton(quotient.data(), remainder.data(),
+                                dividend.data(), size1, divisor.data(), size2);
+        strip_leading_zero_limbs(quotient);
+        strip_leading_zero_limbs(remainder);
     }
-    strip_leading_zeroes(result.value);
-
-    // if the result is 0, set its sign as +
-    if (result.value == "0") result.sign = '+';
 
-    return result;
+    return std::make_tuple(quotient, remainder);
 }
 
+}  // namespace numericxx::detail
+
+#endif  // BIG_INT_DIVISION_HPP
+
 /*
-    BigInt * BigInt
-    ---------------
-    Computes the product of two BigInts using Karatsuba's algorithm.
-    The operand on the RHS of the product is `num`.
+    ===========================================================================
+    Radix conversion
+    ===========================================================================
+    Conversion between magnitudes and digit strings in bases 2 to 36. Small
+    numbers are converted a limb-sized chunk of digits at a time; larger ones
+    are split in half by a cached power of the base, so that conversion costs
+    about as much as a multiplication or division per level of splitting.
 */
 
-BigInt BigInt::operator*(const BigInt& num) const {
-    if (*this == 0 or num == 0) return BigInt(0);
-    if (*this == 1) return num;
-    if (num == 1) return *this;
+#ifndef BIG_INT_RADIX_CONVERSION_HPP
+#define BIG_INT_RADIX_CONVERSION_HPP
 
-    BigInt product;
-    if (abs(*this) <= FLOOR_SQRT_LLONG_MAX and abs(num) <= FLOOR_SQRT_LLONG_MAX)
-        product = std::stoll(this->value) * std::stoll(num.value);
-    else if (is_power_of_10(this->value)) {  // if LHS is a power of 10 do
-                                             // optimised operation
-        product.value = num.value;
-        product.value.append(this->value.begin() + 1, this->value.end());
-    } else if (is_power_of_10(num.value)) {  // if RHS is a power of 10 do
-                                             // optimised operation
-        product.value = this->value;
-        product.value.append(num.value.begin() + 1, num.value.end());
-    } else {
-        // identify the numbers as `larger` and `smaller`
-        std::string larger, smaller;
-        std::tie(larger, smaller) =
-            get_larger_and_smaller(this->value, num.value);
+#include <deque>
+#include <string>
 
-        size_t half_length = larger.size() / 2;
-        auto half_length_ceil = (size_t)ceil(larger.size() / 2.0);
+namespace numericxx::detail {
 
-        BigInt num1_high, num1_low;
-        num1_high = larger.substr(0, half_length);
-        num1_low = larger.substr(half_length);
+// Digits for bases up to 36, in the order of their values
+constexpr char DIGIT_CHARS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
 
-        BigInt num2_high, num2_low;
-        num2_high = smaller.substr(0, half_length);
-        num2_low = smaller.substr(half_length);
+/*
+    RadixChunk
+    ----------
+    The largest number of digits in a base that fit in a limb, and the power
+    of the base they correspond to.
+*/
 
-        strip_leading_zeroes(num1_high.value);
-        strip_leading_zeroes(num1_low.value);
-        strip_leading_zeroes(num2_high.value);
-        strip_leading_zeroes(num2_low.value);
+struct RadixChunk {
+    u64 power;
+    size_t digits;
+};
 
-        BigInt prod_high, prod_mid, prod_low;
-        prod_high = num1_high * num2_high;
-        prod_low = num1_low * num2_low;
-        prod_mid = (num1_high + num1_low) * (num2_high + num2_low) - prod_high -
-                   prod_low;
+RadixChunk radix_chunk(unsigned base) {
+    RadixChunk chunk{base, 1};
+    while (chunk.power <= U64_MAX / base) {
+        chunk.power *= base;
+        chunk.digits++;
+    }
 
-        add_trailing_zeroes(prod_high.value, 2 * half_length_ceil);
-        add_trailing_zeroes(prod_mid.value, half_length_ceil);
+    return chunk;
+}
 
-        strip_leading_zeroes(prod_high.value);
-        strip_leading_zeroes(prod_mid.value);
-        strip_leading_zeroes(prod_low.value);
+/*
+    digit_value
+    -----------
+    Returns the value of a digit character, with letters of either case
+    standing for 10 to 35.
+    NOTE: any other character has the value 36, which is not a digit in any
+    base.
+*/
 
-        product = prod_high + prod_mid + prod_low;
-    }
-    strip_leading_zeroes(product.value);
+unsigned digit_value(char digit) {
+    if (digit >= '0' and digit <= '9') return digit - '0';
 
-    if (this->sign == num.sign)
-        product.sign = '+';
-    else
-        product.sign = '-';
+    char letter = digit | 0x20;
+    if (letter >= 'a' and letter <= 'z') return letter - 'a' + 10;
 
-    return product;
+    return 36;
 }
 
 /*
-    divide
-    ------
-    Helper function that returns the quotient and remainder on dividing the
-    dividend by the divisor, when the divisor is 1 to 10 times the dividend.
+    digits_size
+    -----------
+    Returns an upper bound on the number of digits of a magnitude in a base,
+    which is exact for powers of two.
+    NOTE: zero is counted as a single digit.
 */
 
-std::tuple<BigInt, BigInt> divide(const BigInt& dividend,
-                                  const BigInt& divisor) {
-    BigInt quotient, remainder, temp;
+size_t digits_size(const LimbVector& num, unsigned base) {
+    if (num.empty()) return 1;
 
-    temp = divisor;
-    quotient = 1;
-    while (temp < dividend) {
-        quotient++;
-        temp += divisor;
+    size_t bits = 64 * num.size() - __builtin_clzll(num.back());
+    if ((base & (base - 1)) == 0) {
+        unsigned digit_bits = __builtin_ctz(base);
+        return (bits + digit_bits - 1) / digit_bits;
     }
-    if (temp > dividend) {
-        quotient--;
-        remainder = dividend - (temp - divisor);
+
+    // base^(digits + 1) is at least 2^64 for the digits of a chunk, so each
+    // digit stands for at least 64 / (digits + 1) bits
+    return bits * (radix_chunk(base).digits + 1) / 64 + 1;
+}
+
+/*
+    radix_power
+    -----------
+    Returns chunk^(2^level) for the limb-sized chunk power of a base. The
+    powers are cached per thread, each being the square of the one before.
+    NOTE: the cache outlives any BigIntMemoryScope, so its limbs come from
+    the global heap whatever resource is installed.
+*/
+
+const LimbVector& radix_power(unsigned base, size_t level) {
+    thread_local std::deque<LimbVector> powers[37];
+
+    BigIntMemoryScope global_heap(nullptr);
+    std::deque<LimbVector>& cache = powers[base];
+    if (cache.empty()) {
+        cache.emplace_back(1);
+        cache.back()[0] = radix_chunk(base).power;
     }
+    while (cache.size() <= level)
+        cache.push_back(square_magnitude(cache.back()));
 
-    return std::make_tuple(quotient, remainder);
+    return cache[level];
 }
 
 /*
-    BigInt / BigInt
+    digits_to_limbs
     ---------------
-    Computes the quotient of two BigInts using the long-division method.
-    The operand on the RHS of the division (the divisor) is `num`.
+    Converts `length` digits in a base to a magnitude. Digits in power-of-two
+    bases are packed into the limbs directly; in other bases, long strings are
+    split so that the low part is a power-of-two number of chunks, and the
+    high part is scaled by the matching cached power.
+    NOTE: the digits must be valid in the base.
 */
 
-BigInt BigInt::operator/(const BigInt& num) const {
-    BigInt abs_dividend = abs(*this);
-    BigInt abs_divisor = abs(num);
+LimbVector digits_to_limbs(const char* digits, size_t length, unsigned base) {
+    if ((base & (base - 1)) == 0) {
+        unsigned digit_bits = __builtin_ctz(base);
+        LimbVector num((length * digit_bits + 63) / 64);
+        for (size_t i = 0, bit = length * digit_bits; i < length; i++) {
+            bit -= digit_bits;
+            u64 value = digit_value(digits[i]);
+            num[bit / 64] |= value << bit % 64;
+            if (bit % 64 + digit_bits > 64)
+                num[bit / 64 + 1] |= value >> (64 - bit % 64);
+        }
+        strip_leading_zero_limbs(num);
 
-    if (num == 0) throw std::logic_error("Attempted division by zero");
-    if (abs_dividend < abs_divisor) return BigInt(0);
-    if (num == 1) return *this;
-    if (num == -1) return -(*this);
-
-    BigInt quotient;
-    if (abs_dividend <= LLONG_MAX and abs_divisor <= LLONG_MAX)
-        quotient =
-            std::stoll(abs_dividend.value) / std::stoll(abs_divisor.value);
-    else if (abs_dividend == abs_divisor)
-        quotient = 1;
-    else if (is_power_of_10(
-                 abs_divisor.value)) {  // if divisor is a power of 10 do
-                                        // optimised calculation
-        size_t digits_in_quotient =
-            abs_dividend.value.size() - abs_divisor.value.size() + 1;
-        quotient.value = abs_dividend.value.substr(0, digits_in_quotient);
-    } else {
-        quotient.value = "";  // the value is cleared as digits will be appended
-        BigInt chunk, chunk_quotient, chunk_remainder;
-        size_t chunk_index = 0;
-        chunk_remainder.value = abs_dividend.value.substr(
-            chunk_index, abs_divisor.value.size() - 1);
-        chunk_index = abs_divisor.value.size() - 1;
-        while (chunk_index < abs_dividend.value.size()) {
-            chunk.value = chunk_remainder.value.append(
-                1, abs_dividend.value[chunk_index]);
-            chunk_index++;
-            while (chunk < abs_divisor) {
-                quotient.value += "0";
-                if (chunk_index < abs_dividend.value.size()) {
-                    chunk.value.append(1, abs_dividend.value[chunk_index]);
-                    chunk_index++;
-                } else
-                    break;
-            }
-            if (chunk == abs_divisor) {
-                quotient.value += "1";
-                chunk_remainder = 0;
-            } else if (chunk > abs_divisor) {
-                strip_leading_zeroes(chunk.value);
-                std::tie(chunk_quotient, chunk_remainder) =
-                    divide(chunk, abs_divisor);
-                quotient.value += chunk_quotient.value;
+        return num;
+    }
+
+    RadixChunk chunk = radix_chunk(base);
+    size_t chunks = (length + chunk.digits - 1) / chunk.digits;
+
+    if (chunks < NUMERICXX_BIGINT_RADIX_THRESHOLD) {
+        LimbVector num;
+        size_t chunk_length = length % chunk.digits;
+        if (chunk_length == 0) chunk_length = chunk.digits;
+
+        for (size_t i = 0; i < length; i += chunk_length) {
+            if (i != 0) chunk_length = chunk.digits;
+
+            u64 value = 0, chunk_base = 1;
+            for (size_t j = i; j < i + chunk_length; j++) {
+                value = value * base + digit_value(digits[j]);
+                chunk_base *= base;
             }
+            multiply_add_limb(num, chunk_base, value);
         }
+        strip_leading_zero_limbs(num);
+
+        return num;
     }
-    strip_leading_zeroes(quotient.value);
 
-    if (this->sign == num.sign)
-        quotient.sign = '+';
-    else
-        quotient.sign = '-';
+    size_t level = 0;
+    while ((size_t(2) << level) < chunks) level++;
+    size_t low_length = chunk.digits << level;
 
-    return quotient;
+    LimbVector num = digits_to_limbs(digits, length - low_length, base);
+    LimbVector low = digits_to_limbs(digits + length - low_length, low_length,
+                                     base);
+    num = multiply_magnitudes(num, radix_power(base, level));
+    add_magnitudes_in_place(num, low);
+
+    return num;
 }
 
 /*
-    BigInt % BigInt
+    limbs_to_digits
     ---------------
-    Computes the modulo (remainder on division) of two BigInts.
-    The operand on the RHS of the modulo (the divisor) is `num`.
+    Writes the digits of a magnitude in a base to `out`, padded with leading
+    zeros to `width` digits, and returns the end of the digits written. Digits
+    in power-of-two bases are read off the bits directly; in other bases,
+    large magnitudes are divided by a cached power with a quarter to a half of
+    their limbs, and the quotient and the zero-padded remainder are converted
+    separately.
+    NOTE: there must be room for digits_size(num, base) or `width` digits,
+    whichever is larger. With a zero width, zero has no digits at all.
 */
 
-BigInt BigInt::operator%(const BigInt& num) const {
-    BigInt abs_dividend = abs(*this);
-    BigInt abs_divisor = abs(num);
-
-    if (abs_divisor == 0) throw std::logic_error("Attempted division by zero");
-    if (abs_divisor == 1 or abs_divisor == abs_dividend) return BigInt(0);
-
-    BigInt remainder;
-    if (abs_dividend <= LLONG_MAX and abs_divisor <= LLONG_MAX)
-        remainder =
-            std::stoll(abs_dividend.value) % std::stoll(abs_divisor.value);
-    else if (abs_dividend < abs_divisor)
-        remainder = abs_dividend;
-    else if (is_power_of_10(num.value)) {  // if num is a power of 10 use
-                                           // optimised calculation
-        size_t no_of_zeroes = num.value.size() - 1;
-        remainder.value =
-            abs_dividend.value.substr(abs_dividend.value.size() - no_of_zeroes);
-    } else {
-        BigInt quotient = abs_dividend / abs_divisor;
-        remainder = abs_dividend - quotient * abs_divisor;
+char* limbs_to_digits(char* out, const LimbVector& num, unsigned base,
+                      size_t width = 0) {
+    if ((base & (base - 1)) == 0) {
+        unsigned digit_bits = __builtin_ctz(base);
+        size_t count = num.empty() ? 0 : digits_size(num, base);
+        for (size_t i = std::max(count, width); i-- > count;) *out++ = '0';
+        for (size_t i = count, bit = count * digit_bits; i-- > 0;) {
+            bit -= digit_bits;
+            u64 value = num[bit / 64] >> bit % 64;
+            if (bit % 64 + digit_bits > 64 and bit / 64 + 1 < num.size())
+                value |= num[bit / 64 + 1] << (64 - bit % 64);
+            *out++ = DIGIT_CHARS[value & (base - 1)];
+        }
+
+        return out;
     }
-    strip_leading_zeroes(remainder.value);
 
-    // remainder has the same sign as that of the dividend
-    remainder.sign = this->sign;
-    if (remainder.value == "0")  // except if its zero
-        remainder.sign = '+';
+    RadixChunk chunk = radix_chunk(base);
+
+    // the divisor has about a quarter to a half of the limbs; a number no
+    // longer than it would leave a remainder as long as itself, so it is
+    // converted a chunk at a time instead
+    size_t level = 0;
+    if (num.size() >= NUMERICXX_BIGINT_RADIX_THRESHOLD)
+        while (4 * radix_power(base, level).size() <= num.size()) level++;
+
+    if (num.size() < NUMERICXX_BIGINT_RADIX_THRESHOLD or
+        num.size() <= radix_power(base, level).size()) {
+        ScratchFrame scratch;
+        u64* rest = scratch.allocate(num.size());
+        size_t size = num.size();
+        std::copy(num.begin(), num.end(), rest);
+
+        // digits are written least significant first, then reversed
+        char* first = out;
+        LimbDivisor divisor(chunk.power);
+        while (size != 0) {
+            u64 value = limbs_divrem_1(rest, rest, size, divisor);
+            if (rest[size - 1] == 0) size--;
+            for (size_t i = 0; i < chunk.digits; i++) {
+                *out++ = DIGIT_CHARS[value % base];
+                value /= base;
+                if (size == 0 and value == 0) break;
+            }
+        }
+        while (size_t(out - first) < width) *out++ = '0';
+        std::reverse(first, out);
 
-    return remainder;
-}
+        return out;
+    }
 
-/*
-    BigInt + Integer
-    ----------------
-*/
+    size_t low_width = chunk.digits << level;
 
-BigInt BigInt::operator+(const long long& num) const {
-    return *this + BigInt(num);
+    LimbVector quotient, remainder;
+    std::tie(quotient, remainder) =
+        divide_magnitudes(num, radix_power(base, level));
+    out = limbs_to_digits(out, quotient, base, width ? width - low_width : 0);
+
+    return limbs_to_digits(out, remainder, base, low_width);
 }
 
 /*
-    Integer + BigInt
+    decimal_to_limbs
     ----------------
+    Converts a string of decimal digits to a magnitude.
 */
 
-BigInt operator+(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) + rhs;
+LimbVector decimal_to_limbs(const std::string& digits) {
+    return digits_to_limbs(digits.data(), digits.size(), 10);
 }
 
 /*
-    BigInt - Integer
+    limbs_to_decimal
     ----------------
+    Converts a magnitude to a string of decimal digits.
 */
 
-BigInt BigInt::operator-(const long long& num) const {
-    return *this - BigInt(num);
-}
+std::string limbs_to_decimal(const LimbVector& num) {
+    if (num.empty()) return "0";
 
-/*
-    Integer - BigInt
-    ----------------
-*/
+    std::string digits(digits_size(num, 10), '0');
+    digits.resize(limbs_to_digits(digits.data(), num, 10) - digits.data());
 
-BigInt operator-(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) - rhs;
+    return digits;
 }
 
-/*
-    BigInt * Integer
-    ----------------
-*/
+}  // namespace numericxx::detail
 
-BigInt BigInt::operator*(const long long& num) const {
-    return *this * BigInt(num);
-}
+#endif  // BIG_INT_RADIX_CONVERSION_HPP
 
 /*
-    Integer * BigInt
-    ----------------
+    ===========================================================================
+    Random number generating functions for BigInt
+    ===========================================================================
 */
 
-BigInt operator*(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) * rhs;
-}
+#ifndef BIG_INT_RANDOM_FUNCTIONS_HPP
+#define BIG_INT_RANDOM_FUNCTIONS_HPP
 
-/*
-    BigInt / Integer
-    ----------------
-*/
+#include <random>
+#include <stdexcept>
+#include <vector>
 
-BigInt BigInt::operator/(const long long& num) const {
-    return *this / BigInt(num);
-}
+// when the number of digits are not specified, a random value is used for it
+// which is kept below the following:
+const size_t MAX_RANDOM_LENGTH = 1000;
 
-/*
-    Integer / BigInt
-    ----------------
-*/
+BigInt big_pow10(size_t);
 
-BigInt operator/(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) / rhs;
-}
+namespace numericxx {
 
 /*
-    BigInt % Integer
-    ----------------
+    SplitMix64
+    ----------
+    A counter-based pseudo-random engine: each output is a bijective mix of a
+    counter advanced by a fixed odd step, so it is seedable, cheap to copy and
+    can skip ahead in constant time. Meets the requirements of a uniform
+    random bit generator.
 */
 
-BigInt BigInt::operator%(const long long& num) const {
-    return *this % BigInt(num);
-}
+class SplitMix64 {
+    u64 counter;
 
-/*
-    Integer % BigInt
-    ----------------
-*/
+   public:
+    using result_type = u64;
 
-BigInt operator%(const long long& lhs, const BigInt& rhs) {
-    return BigInt(lhs) % rhs;
-}
+    explicit SplitMix64(u64 seed = 0) : counter(seed) {}
 
-/*
-    BigInt + String
-    ---------------
-*/
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return U64_MAX; }
 
-BigInt BigInt::operator+(const std::string& num) const {
-    return *this + BigInt(num);
-}
+    void seed(u64 seed) { counter = seed; }
+    void discard(u64 count) { counter += count * 0x9e3779b97f4a7c15; }
 
-/*
-    String + BigInt
-    ---------------
-*/
+    result_type operator()() {
+        u64 mixed = counter += 0x9e3779b97f4a7c15;
+        mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111eb;
+        return mixed ^ (mixed >> 31);
+    }
+};
 
-BigInt operator+(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) + rhs;
-}
+namespace detail {
 
 /*
-    BigInt - String
-    ---------------
+    default_random_engine
+    ---------------------
+    Returns the engine used when none is given, seeded once per thread from
+    std::random_device.
 */
 
-BigInt BigInt::operator-(const std::string& num) const {
-    return *this - BigInt(num);
+SplitMix64& default_random_engine() {
+    thread_local SplitMix64 engine([] {
+        std::random_device device;
+        return u64(device()) << 32 | device();
+    }());
+
+    return engine;
 }
 
 /*
-    String - BigInt
-    ---------------
+    random_limb
+    -----------
+    Returns a uniformly random limb drawn from any uniform random bit
+    generator, taking the output of 64-bit engines as it is.
 */
 
-BigInt operator-(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) - rhs;
+template <class Engine>
+u64 random_limb(Engine& engine) {
+    if constexpr (Engine::min() == 0 and Engine::max() == U64_MAX)
+        return engine();
+    else
+        return std::uniform_int_distribution<u64>()(engine);
 }
 
 /*
-    BigInt * String
-    ---------------
+    fill_random_limbs
+    -----------------
+    Fills a magnitude with `bits` uniformly random bits.
 */
 
-BigInt BigInt::operator*(const std::string& num) const {
-    return *this * BigInt(num);
+template <class Engine>
+void fill_random_limbs(LimbVector& num, size_t bits, Engine& engine) {
+    num.resize((bits + 63) / 64);
+    for (size_t i = 0; i < num.size(); i++) num[i] = random_limb(engine);
+    if (bits % 64) num.back() &= U64_MAX >> (64 - bits % 64);
+    strip_leading_zero_limbs(num);
 }
 
+}  // namespace detail
+
+}  // namespace numericxx
+
 /*
-    String * BigInt
-    ---------------
+    random_bits
+    -----------
+    Returns a BigInt uniformly distributed in [0, 2^bits), drawn from
+    `engine`, which can be any uniform random bit generator.
 */
 
-BigInt operator*(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) * rhs;
+template <class Engine>
+BigInt random_bits(size_t bits, Engine& engine) {
+    BigInt num;
+    numericxx::detail::fill_random_limbs(num.limbs, bits, engine);
+
+    return num;
+}
+
+BigInt random_bits(size_t bits) {
+    return random_bits(bits, numericxx::detail::default_random_engine());
 }
 
 /*
-    BigInt / String
-    ---------------
+    random_below
+    ------------
+    Returns a BigInt uniformly distributed in [0, bound), drawn from
+    `engine`. Values of the bit length of the bound are drawn until one is
+    below it, which takes fewer than two draws on average and, unlike taking
+    a remainder, has no bias.
+    NOTE: If the bound is not positive, an invalid_argument exception is
+    thrown.
 */
 
-BigInt BigInt::operator/(const std::string& num) const {
-    return *this / BigInt(num);
+template <class Engine>
+BigInt random_below(const BigInt& bound, Engine& engine) {
+    if (bound.sign == '-' or bound.limbs.empty())
+        throw std::invalid_argument("Expected a positive bound");
+
+    BigInt num;
+    size_t bits = bound.bit_length();
+    const numericxx::detail::LimbVector& limit = bound.limbs;
+    do {
+        numericxx::detail::fill_random_limbs(num.limbs, bits, engine);
+    } while (numericxx::detail::compare_magnitudes(num.limbs, limit) >= 0);
+
+    return num;
+}
+
+BigInt random_below(const BigInt& bound) {
+    return random_below(bound, numericxx::detail::default_random_engine());
 }
 
 /*
-    String / BigInt
-    ---------------
+    append_random_bits
+    ------------------
+    Appends `count` BigInts uniformly distributed in [0, 2^bits) to `nums`.
 */
 
-BigInt operator/(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) / rhs;
+template <class Engine>
+void append_random_bits(std::vector<BigInt>& nums, size_t count, size_t bits,
+                        Engine& engine) {
+    nums.reserve(nums.size() + count);
+    for (size_t i = 0; i < count; i++)
+        nums.push_back(random_bits(bits, engine));
 }
 
 /*
-    BigInt % String
-    ---------------
+    append_random_below
+    -------------------
+    Appends `count` BigInts uniformly distributed in [0, bound) to `nums`.
 */
 
-BigInt BigInt::operator%(const std::string& num) const {
-    return *this % BigInt(num);
+template <class Engine>
+void append_random_below(std::vector<BigInt>& nums, size_t count,
+                         const BigInt& bound, Engine& engine) {
+    nums.reserve(nums.size() + count);
+    for (size_t i = 0; i < count; i++)
+        nums.push_back(random_below(bound, engine));
 }
 
 /*
-    String % BigInt
-    ---------------
+    big_random (num_digits)
+    -----------------------
+    Returns a random BigInt with a specific number of digits, uniformly
+    distributed among those numbers.
 */
 
-BigInt operator%(const std::string& lhs, const BigInt& rhs) {
-    return BigInt(lhs) % rhs;
+BigInt gen_random(size_t num_digits = 0) {
+    numericxx::SplitMix64& engine = numericxx::detail::default_random_engine();
+
+    if (num_digits == 0)  // the number of digits were not specified
+        // use a random number for it:
+        num_digits = 1 + engine() % MAX_RANDOM_LENGTH;
+
+    BigInt smallest = big_pow10(num_digits - 1);
+
+    return smallest + random_below(smallest * 9, engine);
 }
 
-#endif  // BIG_INT_BINARY_ARITHMETIC_OPERATORS_HPP
+#endif  // BIG_INT_RANDOM_FUNCTIONS_HPP
 
 /*
     ===========================================================================
-    Arithmetic-assignment operators
+    Constructors
     ===========================================================================
 */
 
-#ifndef BIG_INT_ARITHMETIC_ASSIGNMENT_OPERATORS_HPP
-#define BIG_INT_ARITHMETIC_ASSIGNMENT_OPERATORS_HPP
+#ifndef BIG_INT_CONSTRUCTORS_HPP
+#define BIG_INT_CONSTRUCTORS_HPP
 
 /*
-    BigInt += BigInt
-    ----------------
+    Default constructor
+    -------------------
 */
 
-BigInt& BigInt::operator+=(const BigInt& num) {
-    *this = *this + num;
-
-    return *this;
-}
+BigInt::BigInt() { sign = '+'; }
 
 /*
-    BigInt -= BigInt
+    Copy constructor
     ----------------
 */
 
-BigInt& BigInt::operator-=(const BigInt& num) {
-    *this = *this - num;
-
-    return *this;
+BigInt::BigInt(const BigInt& num) {
+    limbs = num.limbs;
+    sign = num.sign;
 }
 
 /*
-    BigInt *= BigInt
+    Move constructor
     ----------------
+    Takes over the limbs of `num`, leaving it equal to zero.
 */
 
-BigInt& BigInt::operator*=(const BigInt& num) {
-    *this = *this * num;
+BigInt::BigInt(BigInt&& num) noexcept {
+    limbs = std::move(num.limbs);
+    sign = num.sign;
 
-    return *this;
+    num.limbs.clear();
+    num.sign = '+';
 }
 
 /*
-    BigInt /= BigInt
-    ----------------
+    Integer to BigInt
+    -----------------
 */
 
-BigInt& BigInt::operator/=(const BigInt& num) {
-    *this = *this / num;
-
-    return *this;
+BigInt::BigInt(const long long& num) {
+    // negate in unsigned arithmetic so that LLONG_MIN does not overflow
+    numericxx::u64 magnitude = num < 0 ? -(numericxx::u64)num : num;
+    if (magnitude) limbs.push_back(magnitude);
+    if (num < 0)
+        sign = '-';
+    else
+        sign = '+';
 }
 
 /*
-    BigInt %= BigInt
+    String to BigInt
     ----------------
 */
 
-BigInt& BigInt::operator%=(const BigInt& num) {
-    *this = *this % num;
+BigInt::BigInt(const std::string& num) {
+    std::string magnitude = num;
+    sign = '+';  // positive by default
+    if (num[0] == '+' || num[0] == '-') {  // check for sign
+        magnitude = num.substr(1);
+        sign = num[0];
+    }
+    if (!is_valid_number(magnitude))
+        throw std::invalid_argument("Expected an integer, got \'" + num + "\'");
 
-    return *this;
+    limbs = numericxx::detail::decimal_to_limbs(magnitude);
+    if (limbs.empty()) sign = '+';  // zero is never negative
 }
 
+#endif  // BIG_INT_CONSTRUCTORS_HPP
+
 /*
-    BigInt += Integer
-    -----------------
+    ===========================================================================
+    Conversion functions for BigInt
+    ===========================================================================
 */
 
-BigInt& BigInt::operator+=(const long long& num) {
-    *this = *this + BigInt(num);
+#ifndef BIG_INT_CONVERSION_FUNCTIONS_HPP
+#define BIG_INT_CONVERSION_FUNCTIONS_HPP
 
-    return *this;
+#include <climits>
+#include <stdexcept>
+
+/*
+    check_base
+    ----------
+    Checks that a base for conversion to and from characters is within 2 to
+    36, throwing an invalid_argument exception otherwise.
+*/
+
+void check_base(int base) {
+    if (base < 2 or base > 36)
+        throw std::invalid_argument("Expected a base from 2 to 36, got " +
+                                    std::to_string(base));
 }
 
 /*
-    BigInt -= Integer
-    -----------------
+    to_chars_size
+    -------------
+    Returns an upper bound on the number of characters to_chars writes for a
+    BigInt in the given base, including the sign.
 */
 
-BigInt& BigInt::operator-=(const long long& num) {
-    *this = *this - BigInt(num);
+size_t to_chars_size(const BigInt& num, int base = 10) {
+    check_base(base);
 
-    return *this;
+    return (num.sign == '-') + numericxx::detail::digits_size(num.limbs, base);
 }
 
 /*
-    BigInt *= Integer
-    -----------------
+    to_chars
+    --------
+    Writes a BigInt in the given base to the buffer [first, last), like
+    std::to_chars: lowercase letters for digits above 9, a minus sign for
+    negative numbers and no prefix. Returns the end of the characters written,
+    or `last` with errc::value_too_large if they do not fit.
+    NOTE: buffers of at least to_chars_size characters are written to
+    directly. Smaller ones may still fit the number, which is then formatted
+    aside first.
 */
 
-BigInt& BigInt::operator*=(const long long& num) {
-    *this = *this * BigInt(num);
+std::to_chars_result to_chars(char* first, char* last, const BigInt& num,
+                              int base = 10) {
+    size_t size = to_chars_size(num, base);
 
-    return *this;
+    if (size_t(last - first) >= size) {
+        if (num.sign == '-') *first++ = '-';
+        if (num.limbs.empty()) *first++ = '0';
+        return {numericxx::detail::limbs_to_digits(first, num.limbs, base),
+                std::errc()};
+    }
+
+    std::string chars(size, '\0');
+    char* end = to_chars(chars.data(), chars.data() + size, num, base).ptr;
+    if (end - chars.data() > last - first)
+        return {last, std::errc::value_too_large};
+
+    return {std::copy(chars.data(), end, first), std::errc()};
 }
 
 /*
-    BigInt /= Integer
-    -----------------
+    from_chars
+    ----------
+    Parses a BigInt in the given base from the buffer [first, last), like
+    std::from_chars: an optional minus sign followed by digits, with letters
+    of either case for digits above 9. Parsing stops at the first character
+    that is not a digit in the base. Returns the end of the characters parsed,
+    or `first` with errc::invalid_argument if there are no digits, in which
+    case `num` is left unchanged.
 */
 
-BigInt& BigInt::operator/=(const long long& num) {
-    *this = *this / BigInt(num);
+std::from_chars_result from_chars(const char* first, const char* last,
+                                  BigInt& num, int base = 10) {
+    check_base(base);
 
-    return *this;
+    const char* digits = first;
+    if (digits != last and *digits == '-') digits++;
+    const char* end = digits;
+    while (end != last and
+           numericxx::detail::digit_value(*end) < unsigned(base))
+        end++;
+    if (end == digits) return {first, std::errc::invalid_argument};
+
+    bool negative = digits != first;
+    while (digits != end and *digits == '0') digits++;  // skip leading zeros
+    num.limbs = numericxx::detail::digits_to_limbs(digits, end - digits, base);
+    num.sign = negative and !num.limbs.empty() ? '-' : '+';
+
+    return {end, std::errc()};
 }
 
 /*
-    BigInt %= Integer
-    -----------------
+    to_string
+    ---------
+    Converts a BigInt to a string.
 */
 
-BigInt& BigInt::operator%=(const long long& num) {
-    *this = *this % BigInt(num);
+std::string BigInt::to_string() const {
+    std::string chars(to_chars_size(*this), '\0');
+    char* end = to_chars(chars.data(), chars.data() + chars.size(), *this).ptr;
+    chars.resize(end - chars.data());
 
-    return *this;
+    return chars;
 }
 
 /*
-    BigInt += String
-    ----------------
+    to_int
+    ------
+    Converts a BigInt to an int.
+    NOTE: If the BigInt is out of range of an int, an out_of_range exception
+    is thrown.
 */
 
-BigInt& BigInt::operator+=(const std::string& num) {
-    *this = *this + BigInt(num);
+int BigInt::to_int() const {
+    long long num = this->to_long_long();
+    if (num < INT_MIN or num > INT_MAX)
+        throw std::out_of_range("BigInt out of range of int");
 
-    return *this;
+    return num;
 }
 
 /*
-    BigInt -= String
-    ----------------
+    to_long
+    -------
+    Converts a BigInt to a long int.
+    NOTE: If the BigInt is out of range of a long int, an out_of_range
+    exception is thrown.
 */
 
-BigInt& BigInt::operator-=(const std::string& num) {
-    *this = *this - BigInt(num);
+long BigInt::to_long() const {
+    long long num = this->to_long_long();
+    if (num < LONG_MIN or num > LONG_MAX)
+        throw std::out_of_range("BigInt out of range of long");
 
-    return *this;
+    return num;
 }
 
 /*
-    BigInt *= String
-    ----------------
+    to_long_long
+    ------------
+    Converts a BigInt to a long long int.
+    NOTE: If the BigInt is out of range of a long long int, an out_of_range
+    exception is thrown.
 */
 
-BigInt& BigInt::operator*=(const std::string& num) {
-    *this = *this * BigInt(num);
+long long BigInt::to_long_long() const {
+    if (limbs.empty()) return 0;
 
-    return *this;
+    // the magnitude of LLONG_MIN is one more than LLONG_MAX
+    numericxx::u64 max_magnitude = (numericxx::u64)LLONG_MAX + (sign == '-');
+    if (limbs.size() > 1 or limbs[0] > max_magnitude)
+        throw std::out_of_range("BigInt out of range of long long");
+
+    return sign == '-' ? -(long long)(limbs[0] - 1) - 1 : (long long)limbs[0];
 }
 
 /*
-    BigInt /= String
-    ----------------
+    try_get_i128
+    ------------
+    Stores the value of a BigInt in `value` and returns true if it is in range
+    of a signed 128-bit integer, otherwise returns false.
 */
 
-BigInt& BigInt::operator/=(const std::string& num) {
-    *this = *this / BigInt(num);
+bool BigInt::try_get_i128(numericxx::i128& value) const {
+    if (limbs.size() > 2) return false;
 
-    return *this;
+    numericxx::u128 magnitude = 0;
+    if (limbs.size() > 0) magnitude = limbs[0];
+    if (limbs.size() > 1) magnitude |= (numericxx::u128)limbs[1] << 64;
+
+    // the magnitude of I128_MIN is one more than I128_MAX
+    if (magnitude > (numericxx::u128)numericxx::I128_MAX + (sign == '-'))
+        return false;
+
+    value = sign == '-' ? -(numericxx::i128)(magnitude - 1) - 1
+                        : (numericxx::i128)magnitude;
+    return true;
 }
 
 /*
-    BigInt %= String
-    ----------------
+    assign_i128
+    -----------
+    Sets a BigInt to the value of a signed 128-bit integer, reusing its limbs.
 */
 
-BigInt& BigInt::operator%=(const std::string& num) {
-    *this = *this % BigInt(num);
+void BigInt::assign_i128(numericxx::i128 value) {
+    numericxx::u128 magnitude =
+        value < 0 ? -(numericxx::u128)value : (numericxx::u128)value;
 
-    return *this;
+    limbs.clear();
+    if (magnitude) limbs.push_back((numericxx::u64)magnitude);
+    if (magnitude >> 64) limbs.push_back((numericxx::u64)(magnitude >> 64));
+    sign = value < 0 ? '-' : '+';
 }
 
-#endif  // BIG_INT_ARITHMETIC_ASSIGNMENT_OPERATORS_HPP
+#endif  // BIG_INT_CONVERSION_FUNCTIONS_HPP
 
 /*
     ===========================================================================
-    Increment and decrement operators
+    Assignment operators
     ===========================================================================
 */
 
-#ifndef BIG_INT_INCREMENT_DECREMENT_OPERATORS_HPP
-#define BIG_INT_INCREMENT_DECREMENT_OPERATORS_HPP
+#ifndef BIG_INT_ASSIGNMENT_OPERATORS_HPP
+#define BIG_INT_ASSIGNMENT_OPERATORS_HPP
 
 /*
-    Pre-increment
-    -------------
-    ++BigInt
+    BigInt = BigInt
+    ---------------
 */
 
-BigInt& BigInt::operator++() {
-    *this += 1;
+BigInt& BigInt::operator=(const BigInt& num) {
+    limbs = num.limbs;
+    sign = num.sign;
 
     return *this;
 }
 
 /*
-    Pre-decrement
-    -------------
-    --BigInt
+    BigInt = BigInt (move)
+    ----------------------
+    Takes over the limbs of `num`, leaving it equal to zero.
 */
 
-BigInt& BigInt::operator--() {
-    *this -= 1;
+BigInt& BigInt::operator=(BigInt&& num) noexcept {
+    if (this != &num) {
+        limbs = std::move(num.limbs);
+        sign = num.sign;
+
+        num.limbs.clear();
+        num.sign = '+';
+    }
 
     return *this;
 }
 
 /*
-    Post-increment
-    --------------
-    BigInt++
+    BigInt = Integer
+    ----------------
 */
 
-BigInt BigInt::operator++(int) {
-    BigInt temp = *this;
-    *this += 1;
+BigInt& BigInt::operator=(const long long& num) {
+    BigInt temp(num);
+    limbs = std::move(temp.limbs);
+    sign = temp.sign;
 
-    return temp;
+    return *this;
 }
 
 /*
-    Post-decrement
-    --------------
-    BigInt--
+    BigInt = String
+    ---------------
 */
 
-BigInt BigInt::operator--(int) {
-    BigInt temp = *this;
-    *this -= 1;
+BigInt& BigInt::operator=(const std::string& num) {
+    BigInt temp(num);
+    limbs = std::move(temp.limbs);
+    sign = temp.sign;
 
-    return temp;
+    return *this;
 }
 
-#endif  // BIG_INT_INCREMENT_DECREMENT_OPERATORS_HPP
+#endif  // BIG_INT_ASSIGNMENT_OPERATORS_HPP
 
 /*
     ===========================================================================
-    I/O stream operators
+    Unary arithmetic operators
     ===========================================================================
 */
 
-#ifndef BIG_INT_IO_STREAM_OPERATORS_HPP
-#define BIG_INT_IO_STREAM_OPERATORS_HPP
+#ifndef BIG_INT_UNARY_ARITHMETIC_OPERATORS_HPP
+#define BIG_INT_UNARY_ARITHMETIC_OPERATORS_HPP
 
 /*
-    BigInt from input stream
-    ------------------------
+    +BigInt
+    -------
+    Returns the value of a BigInt.
+    NOTE: This function does not return the absolute value. To get the absolute
+    value of a BigInt, use the `abs` function.
 */
 
-std::istream& operator>>(std::istream& in, BigInt& num) {
-    std::string input;
-    in >> input;
-    num = BigInt(input);  // remove sign from value and set sign, if exists
+BigInt BigInt::operator+() const { return *this; }
 
-    return in;
+/*
+    -BigInt
+    -------
+    Returns the negative of a BigInt.
+*/
+
+BigInt BigInt::operator-() const& {
+    BigInt temp;
+
+    temp.limbs = limbs;
+    if (!limbs.empty()) {
+        if (sign == '+')
+            temp.sign = '-';
+        else
+            temp.sign = '+';
+    }
+
+    return temp;
 }
 
 /*
-    BigInt to output stream
-    -----------------------
+    -BigInt (rvalue)
+    ----------------
+    Negates a temporary BigInt in place.
 */
 
-std::ostream& operator<<(std::ostream& out, const BigInt& num) {
-    if (num.sign == '-') out << num.sign;
-    out << num.value;
+BigInt BigInt::operator-() && {
+    if (!limbs.empty()) sign = sign == '+' ? '-' : '+';
 
-    return out;
+    return std::move(*this);
 }
 
-#endif  // BIG_INT_IO_STREAM_OPERATORS_HPP
+#endif  // BIG_INT_UNARY_ARITHMETIC_OPERATORS_HPP
 
 /*
     ===========================================================================
-    Type specializations for BigInt
+    Relational operators
     ===========================================================================
+    All operators depend on `compare`, which orders a BigInt against another
+    BigInt, an integer or a string without constructing a temporary BigInt.
 */
-#ifndef BIGINT_TYPE_SPECIALIZATIONS_HPP
-#define BIGINT_TYPE_SPECIALIZATIONS_HPP
 
-/**
- * std::is_void<>
- */
-template <>
-struct std::is_void<BigInt> : std::false_type {};
+#ifndef BIG_INT_RELATIONAL_OPERATORS_HPP
+#define BIG_INT_RELATIONAL_OPERATORS_HPP
 
-/**
- * std::is_null_pointer<>
- */
-template <>
-struct std::is_null_pointer<BigInt> : std::false_type {};
+#include <compare>
+#include <stdexcept>
+#include <string_view>
 
-/**
- * std::is_integral<>
- */
-template <>
-struct std::is_integral<BigInt> : std::true_type {};
+/*
+    compare (BigInt)
+    ----------------
+    Returns a negative value, zero or a positive value as the BigInt is less
+    than, equal to or greater than `num`.
+*/
 
-/**
- * std::is_floating_point<>
- */
-template <>
-struct std::is_floating_point<BigInt> : std::false_type {};
+int BigInt::compare(const BigInt& num) const {
+    if (sign != num.sign) return sign == '-' ? -1 : 1;
 
-/**
- * std::is_array<>
- */
-template <>
-struct std::is_array<BigInt> : std::false_type {};
+    int result = numericxx::detail::compare_magnitudes(limbs, num.limbs);
+    return sign == '-' ? -result : result;
+}
 
-/**
- * std::is_enum<>
- */
-template <>
-struct std::is_enum<BigInt> : std::false_type {};
+/*
+    compare (Integer)
+    -----------------
+*/
 
-/**
- * std::is_union<>
- */
-template <>
-struct std::is_union<BigInt> : std::false_type {};
+int BigInt::compare(const long long& num) const {
+    char num_sign = num < 0 ? '-' : '+';
+    if (sign != num_sign) return sign == '-' ? -1 : 1;
+
+    numericxx::u64 magnitude = num < 0 ? -(numericxx::u64)num : num;
+    int result;
+    if (limbs.size() > 1)
+        result = 1;
+    else {
+        numericxx::u64 value = limbs.empty() ? 0 : limbs[0];
+        result = (value > magnitude) - (value < magnitude);
+    }
 
-/**
- * std::is_class<>
- * TODO: check if this is correct
- */
-template <>
-struct std::is_class<BigInt> : std::true_type {};
+    return sign == '-' ? -result : result;
+}
 
-/**
- * std::is_function<>
- */
-template <>
-struct std::is_function<BigInt> : std::false_type {};
+/*
+    compare (String)
+    ----------------
+    Compares against a decimal string with an optional sign, as accepted by
+    the string constructor. Strings whose length already tells the order are
+    not converted at all, and the others are converted without allocating as
+    long as they fit in two limbs.
+    NOTE: If the string is not a valid integer, an invalid_argument exception
+    is thrown.
+*/
 
-/**
- * std::is_pointer<>
- */
-template <>
-struct std::is_pointer<BigInt> : std::false_type {};
+int BigInt::compare(std::string_view num) const {
+    std::string_view digits = num;
+    char num_sign = '+';
+    if (!digits.empty() and (digits[0] == '+' or digits[0] == '-')) {
+        num_sign = digits[0];
+        digits.remove_prefix(1);
+    }
+    for (char digit : digits)
+        if (digit < '0' or digit > '9')
+            throw std::invalid_argument("Expected an integer, got \'" +
+                                        std::string(num) + "\'");
+
+    size_t first_significant = digits.find_first_not_of('0');
+    digits.remove_prefix(std::min(first_significant, digits.size()));
+    if (digits.empty()) num_sign = '+';  // zero is never negative
+
+    if (sign != num_sign) return sign == '-' ? -1 : 1;
+
+    int result;
+    // a number of d digits is in [10^(d - 1), 10^d), and one of b bits in
+    // [2^(b - 1), 2^b), with 3.32 < log2(10) < 3.33
+    size_t bits = limbs.empty()
+                      ? 0
+                      : 64 * limbs.size() - __builtin_clzll(limbs.back());
+    if (digits.empty())
+        result = bits != 0;
+    else if ((digits.size() - 1) * 332 / 100 >= bits)
+        result = -1;
+    else if ((digits.size() * 333 + 99) / 100 < bits)
+        result = 1;
+    else
+        result = numericxx::detail::compare_magnitudes(
+            limbs, numericxx::detail::digits_to_limbs(digits.data(),
+                                                      digits.size(), 10));
+
+    return sign == '-' ? -result : result;
+}
+
+/*
+    compare (std::string, C string)
+    -------------------------------
+    Pick the string_view overload over converting the string to a BigInt.
+*/
+
+int BigInt::compare(const std::string& num) const {
+    return compare(std::string_view(num));
+}
+
+int BigInt::compare(const char* num) const {
+    return compare(std::string_view(num));
+}
+
+/*
+    BigInt <=> BigInt
+    -----------------
+*/
+
+std::strong_ordering BigInt::operator<=>(const BigInt& num) const {
+    return compare(num) <=> 0;
+}
+
+/*
+    BigInt <=> Integer
+    ------------------
+*/
+
+std::strong_ordering BigInt::operator<=>(const long long& num) const {
+    return compare(num) <=> 0;
+}
+
+/*
+    BigInt <=> String
+    -----------------
+*/
+
+std::strong_ordering BigInt::operator<=>(std::string_view num) const {
+    return compare(num) <=> 0;
+}
+
+std::strong_ordering BigInt::operator<=>(const std::string& num) const {
+    return compare(num) <=> 0;
+}
+
+std::strong_ordering BigInt::operator<=>(const char* num) const {
+    return compare(num) <=> 0;
+}
+
+/*
+    BigInt == BigInt
+    ----------------
+*/
+
+bool BigInt::operator==(const BigInt& num) const {
+    return (sign == num.sign) and (limbs == num.limbs);
+}
+
+/*
+    BigInt != BigInt
+    ----------------
+*/
+
+bool BigInt::operator!=(const BigInt& num) const {
+    return compare(num) != 0;
+}
+
+/*
+    BigInt < BigInt
+    ---------------
+*/
+
+bool BigInt::operator<(const BigInt& num) const {
+    return compare(num) < 0;
+}
+
+/*
+    BigInt > BigInt
+    ---------------
+*/
+
+bool BigInt::operator>(const BigInt& num) const {
+    return compare(num) > 0;
+}
+
+/*
+    BigInt <= BigInt
+    ----------------
+*/
+
+bool BigInt::operator<=(const BigInt& num) const {
+    return compare(num) <= 0;
+}
+
+/*
+    BigInt >= BigInt
+    ----------------
+*/
+
+bool BigInt::operator>=(const BigInt& num) const {
+    return compare(num) >= 0;
+}
+
+/*
+    BigInt == Integer
+    -----------------
+*/
+
+bool BigInt::operator==(const long long& num) const {
+    return compare(num) == 0;
+}
+
+/*
+    Integer == BigInt
+    -----------------
+*/
+
+bool operator==(const long long& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) == 0;
+}
+
+/*
+    BigInt != Integer
+    -----------------
+*/
+
+bool BigInt::operator!=(const long long& num) const {
+    return compare(num) != 0;
+}
+
+/*
+    Integer != BigInt
+    -----------------
+*/
+
+bool operator!=(const long long& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) != 0;
+}
+
+/*
+    BigInt < Integer
+    ----------------
+*/
+
+bool BigInt::operator<(const long long& num) const {
+    return compare(num) < 0;
+}
+
+/*
+    Integer < BigInt
+    ----------------
+*/
+
+bool operator<(const long long& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) > 0;
+}
+
+/*
+    BigInt > Integer
+    ----------------
+*/
+
+bool BigInt::operator>(const long long& num) const {
+    return compare(num) > 0;
+}
+
+/*
+    Integer > BigInt
+    ----------------
+*/
+
+bool operator>(const long long& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) < 0;
+}
+
+/*
+    BigInt <= Integer
+    -----------------
+*/
+
+bool BigInt::operator<=(const long long& num) const {
+    return compare(num) <= 0;
+}
+
+/*
+    Integer <= BigInt
+    -----------------
+*/
+
+bool operator<=(const long long& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) >= 0;
+}
+
+/*
+    BigInt >= Integer
+    -----------------
+*/
+
+bool BigInt::operator>=(const long long& num) const {
+    return compare(num) >= 0;
+}
+
+/*
+    Integer >= BigInt
+    -----------------
+*/
+
+bool operator>=(const long long& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) <= 0;
+}
+
+/*
+    BigInt == String
+    ----------------
+*/
+
+bool BigInt::operator==(const std::string& num) const {
+    return compare(num) == 0;
+}
+
+/*
+    String == BigInt
+    ----------------
+*/
+
+bool operator==(const std::string& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) == 0;
+}
+
+/*
+    BigInt != String
+    ----------------
+*/
+
+bool BigInt::operator!=(const std::string& num) const {
+    return compare(num) != 0;
+}
+
+/*
+    String != BigInt
+    ----------------
+*/
+
+bool operator!=(const std::string& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) != 0;
+}
+
+/*
+    BigInt < String
+    ---------------
+*/
+
+bool BigInt::operator<(const std::string& num) const {
+    return compare(num) < 0;
+}
+
+/*
+    String < BigInt
+    ---------------
+*/
+
+bool operator<(const std::string& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) > 0;
+}
+
+/*
+    BigInt > String
+    ---------------
+*/
+
+bool BigInt::operator>(const std::string& num) const {
+    return compare(num) > 0;
+}
+
+/*
+    String > BigInt
+    ---------------
+*/
+
+bool operator>(const std::string& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) < 0;
+}
+
+/*
+    BigInt <= String
+    ----------------
+*/
+
+bool BigInt::operator<=(const std::string& num) const {
+    return compare(num) <= 0;
+}
+
+/*
+    String <= BigInt
+    ----------------
+*/
+
+bool operator<=(const std::string& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) >= 0;
+}
+
+/*
+    BigInt >= String
+    ----------------
+*/
+
+bool BigInt::operator>=(const std::string& num) const {
+    return compare(num) >= 0;
+}
+
+/*
+    String >= BigInt
+    ----------------
+*/
+
+bool operator>=(const std::string& lhs, const BigInt& rhs) {
+    return rhs.compare(lhs) <= 0;
+}
+
+#endif  // BIG_INT_RELATIONAL_OPERATORS_HPP
+
+/*
+    ===========================================================================
+    Math functions for BigInt
+    ===========================================================================
+*/
+
+#ifndef BIG_INT_MATH_FUNCTIONS_HPP
+#define BIG_INT_MATH_FUNCTIONS_HPP
+
+#include <string>
+
+/*
+    abs
+    ---
+    Returns the absolute value of a BigInt.
+*/
+
+BigInt abs(const BigInt& num) { return num < 0 ? -num : num; }
+
+/*
+    square
+    ------
+    Returns the square of a BigInt, which costs noticeably less than
+    multiplying two different BigInts of the same size.
+*/
+
+BigInt square(const BigInt& num) {
+    BigInt result;
+
+    numericxx::i128 value, small_square;
+    if (num.try_get_i128(value) and
+        !__builtin_mul_overflow(value, value, &small_square)) {
+        result.assign_i128(small_square);
+        return result;
+    }
+
+    result.limbs = numericxx::detail::square_magnitude(num.limbs);
+
+    return result;
+}
+
+/*
+    big_pow10
+    ---------
+    Returns a BigInt equal to 10^exp, as a product of the cached powers
+    10^(19 * 2^i) picked out by the bits of exp / 19.
+    NOTE: exponent should be a non-negative integer.
+*/
+
+BigInt big_pow10(size_t exp) {
+    numericxx::detail::RadixChunk chunk = numericxx::detail::radix_chunk(10);
+
+    BigInt result = 1;
+    for (size_t i = 0; i < exp % chunk.digits; i++) result *= 10;
+    for (size_t level = 0, chunks = exp / chunk.digits; chunks;
+         level++, chunks >>= 1)
+        if (chunks & 1)
+            result.limbs = numericxx::detail::multiply_magnitudes(
+                result.limbs, numericxx::detail::radix_power(10, level));
+
+    return result;
+}
+
+/*
+    pow (BigInt)
+    ------------
+    Returns a BigInt equal to base^exp.
+*/
+
+BigInt pow(const BigInt& base, int exp) {
+    if (exp < 0) {
+        if (base == 0) throw std::logic_error("Cannot divide by zero");
+        return base == 1 or base == -1 ? base : 0;
+    }
+    if (exp == 0) {
+        if (base == 0) throw std::logic_error("Zero cannot be raised to zero");
+        return 1;
+    }
+
+    BigInt result = base, result_odd = 1;
+    while (exp > 1) {
+        if (exp % 2) result_odd *= result;
+        result = square(result);
+        exp /= 2;
+    }
+
+    return result * result_odd;
+}
+
+/*
+    pow (Integer)
+    -------------
+    Returns a BigInt equal to base^exp.
+*/
+
+BigInt pow(const long long& base, int exp) { return pow(BigInt(base), exp); }
+
+/*
+    pow (String)
+    ------------
+    Returns a BigInt equal to base^exp.
+*/
+
+BigInt pow(const std::string& base, int exp) { return pow(BigInt(base), exp); }
+
+/*
+    sqrt
+    ----
+    Returns the positive integer square root of a BigInt using Newton's method.
+    NOTE: the input must be non-negative.
+*/
+
+BigInt sqrt(const BigInt& num) {
+    if (num < 0)
+        throw std::invalid_argument(
+            "Cannot compute square root of a negative integer");
+
+    // Optimisations for small inputs:
+    if (num == 0)
+        return 0;
+    else if (num < 4)
+        return 1;
+    else if (num < 9)
+        return 2;
+    else if (num < 16)
+        return 3;
+
+    // 2^ceil(bits / 2) is at least the square root, and from above the
+    // iterates decrease until they reach it
+    BigInt sqrt_prev, sqrt_current = BigInt(1) << (num.bit_length() + 1) / 2;
+    do {
+        sqrt_prev = std::move(sqrt_current);
+        sqrt_current = (num / sqrt_prev + sqrt_prev) >> 1;
+    } while (sqrt_current < sqrt_prev);
+
+    return sqrt_prev;
+}
+
+/*
+    divmod
+    ------
+    Returns the quotient and the remainder on dividing `dividend` by
+    `divisor`, both from a single division. The quotient is truncated towards
+    zero and the remainder has the sign of the dividend, as with the / and %
+    operators.
+*/
+
+std::tuple<BigInt, BigInt> divmod(const BigInt& dividend,
+                                  const BigInt& divisor) {
+    if (divisor.limbs.empty())
+        throw std::logic_error("Attempted division by zero");
+
+    BigInt quotient, remainder;
+    if (numericxx::detail::compare_magnitudes(dividend.limbs, divisor.limbs) <
+        0) {
+        remainder = dividend;
+        return {std::move(quotient), std::move(remainder)};
+    }
+
+    // divide small values natively (I128_MIN / -1 overflows)
+    numericxx::i128 small_dividend, small_divisor;
+    if (dividend.try_get_i128(small_dividend) and
+        divisor.try_get_i128(small_divisor) and
+        !(small_dividend == numericxx::I128_MIN and small_divisor == -1)) {
+        quotient.assign_i128(small_dividend / small_divisor);
+        remainder.assign_i128(small_dividend % small_divisor);
+        return {std::move(quotient), std::move(remainder)};
+    }
+
+    std::tie(quotient.limbs, remainder.limbs) =
+        numericxx::detail::divide_magnitudes(dividend.limbs, divisor.limbs);
+
+    // the quotient is non-zero here, and a zero remainder stays positive
+    if (dividend.sign != divisor.sign) quotient.sign = '-';
+    if (!remainder.limbs.empty()) remainder.sign = dividend.sign;
+
+    return {std::move(quotient), std::move(remainder)};
+}
+
+/*
+    divmod_floor
+    ------------
+    Returns the quotient and the remainder on dividing `dividend` by
+    `divisor`, with the quotient rounded towards negative infinity, so that
+    the remainder has the sign of the divisor.
+*/
+
+std::tuple<BigInt, BigInt> divmod_floor(const BigInt& dividend,
+                                        const BigInt& divisor) {
+    BigInt quotient, remainder;
+    std::tie(quotient, remainder) = divmod(dividend, divisor);
+
+    if (remainder != 0 and (remainder < 0) != (divisor < 0)) {
+        quotient -= 1;
+        remainder += divisor;
+    }
+
+    return {std::move(quotient), std::move(remainder)};
+}
+
+#endif  // BIG_INT_MATH_FUNCTIONS_HPP
+
+/*
+    ===========================================================================
+    Fused multiply-add functions
+    ===========================================================================
+    Accumulate products into a BigInt without building them as BigInts of
+    their own. Products with a short operand are added row by row into the
+    limbs of the accumulator.
+*/
+
+#ifndef BIG_INT_FUSED_MULTIPLY_ADD_HPP
+#define BIG_INT_FUSED_MULTIPLY_ADD_HPP
+
+namespace numericxx::detail {
+
+/*
+    addmul_magnitudes
+    -----------------
+    Adds the product of the magnitudes `num1` and `num2` to the magnitude
+    `acc`, or subtracts it, leaving the absolute value of the result in `acc`.
+    Returns true if the subtraction changes the sign.
+    NOTE: `acc` may be the same vector as `num1` or `num2`.
+*/
+
+bool addmul_magnitudes(LimbVector& acc, const LimbVector& num1,
+                       const LimbVector& num2, bool subtract) {
+    const LimbVector& longer = num1.size() >= num2.size() ? num1 : num2;
+    const LimbVector& shorter = num1.size() >= num2.size() ? num2 : num1;
+
+    if (shorter.size() >= NUMERICXX_BIGINT_KARATSUBA_THRESHOLD or
+        &acc == &num1 or &acc == &num2) {
+        LimbVector product = multiply_magnitudes(num1, num2);
+        if (subtract) return subtract_magnitudes_in_place(acc, product);
+
+        add_magnitudes_in_place(acc, product);
+        return false;
+    }
+
+    // with a spare limb on top, a difference that goes negative wraps around
+    // to a number with a non-zero top limb
+    size_t size = std::max(acc.size(), longer.size() + shorter.size()) + 1;
+    acc.resize(size);
+    for (size_t i = 0; i < shorter.size(); i++) {
+        u64* row = acc.data() + i;
+        u64* above = row + longer.size();
+        size_t rest = size - i - longer.size();
+        if (subtract)
+            limbs_sub_1(above, above, rest,
+                        limbs_submul_1(row, longer.data(), longer.size(),
+                                       shorter[i]));
+        else
+            limbs_add_1(above, above, rest,
+                        limbs_addmul_1(row, longer.data(), longer.size(),
+                                       shorter[i]));
+    }
+
+    bool flipped = subtract and acc.back() != 0;
+    if (flipped) {  // negate the wrapped difference
+        u64 carry = 1;
+        for (u64& limb : acc) {
+            limb = ~limb + carry;
+            carry &= limb == 0;
+        }
+    }
+    strip_leading_zero_limbs(acc);
+
+    return flipped;
+}
+
+}  // namespace numericxx::detail
+
+/*
+    add_product
+    -----------
+    Adds the product of two magnitudes, whose sign is `product_sign`, to this
+    BigInt in place.
+*/
+
+void BigInt::add_product(const numericxx::detail::LimbVector& num1,
+                         const numericxx::detail::LimbVector& num2,
+                         char product_sign) {
+    if (num1.empty() or num2.empty()) return;
+    if (limbs.empty()) sign = product_sign;
+
+    if (numericxx::detail::addmul_magnitudes(limbs, num1, num2,
+                                             sign != product_sign))
+        sign = product_sign;
+    if (limbs.empty()) sign = '+';  // zero is never negative
+}
+
+/*
+    addmul (BigInt)
+    ---------------
+    Replaces `acc` by `acc + num1 * num2`.
+*/
+
+void addmul(BigInt& acc, const BigInt& num1, const BigInt& num2) {
+    acc.add_product(num1.limbs, num2.limbs, num1.sign == num2.sign ? '+' : '-');
+}
+
+/*
+    submul (BigInt)
+    ---------------
+    Replaces `acc` by `acc - num1 * num2`.
+*/
+
+void submul(BigInt& acc, const BigInt& num1, const BigInt& num2) {
+    acc.add_product(num1.limbs, num2.limbs, num1.sign == num2.sign ? '-' : '+');
+}
+
+/*
+    addmul (Integer)
+    ----------------
+    Replaces `acc` by `acc + num1 * num2`, for a single-word `num2`.
+*/
+
+void addmul(BigInt& acc, const BigInt& num1, const long long& num2) {
+    numericxx::detail::LimbVector word;
+    if (num2 != 0) word.push_back(num2 < 0 ? -(numericxx::u64)num2 : num2);
+    acc.add_product(num1.limbs, word,
+                    (num1.sign == '-') == (num2 < 0) ? '+' : '-');
+}
+
+/*
+    submul (Integer)
+    ----------------
+    Replaces `acc` by `acc - num1 * num2`, for a single-word `num2`.
+*/
+
+void submul(BigInt& acc, const BigInt& num1, const long long& num2) {
+    numericxx::detail::LimbVector word;
+    if (num2 != 0) word.push_back(num2 < 0 ? -(numericxx::u64)num2 : num2);
+    acc.add_product(num1.limbs, word,
+                    (num1.sign == '-') == (num2 < 0) ? '-' : '+');
+}
+
+/*
+    mul_word_add
+    ------------
+    Replaces `num` by `num * multiplier + addend`, the step of Horner's rule.
+    Non-negative operands are handled in a single pass over the limbs.
+*/
+
+void mul_word_add(BigInt& num, const long long& multiplier,
+                  const long long& addend) {
+    if (num.sign == '+' and multiplier >= 0 and addend >= 0) {
+        numericxx::detail::multiply_add_limb(num.limbs, multiplier, addend);
+        numericxx::detail::strip_leading_zero_limbs(num.limbs);
+        return;
+    }
+
+    num *= multiplier;
+    num += addend;
+}
+
+#endif  // BIG_INT_FUSED_MULTIPLY_ADD_HPP
+
+/*
+    ===========================================================================
+    Binary arithmetic operators
+    ===========================================================================
+*/
+
+#ifndef BIG_INT_BINARY_ARITHMETIC_OPERATORS_HPP
+#define BIG_INT_BINARY_ARITHMETIC_OPERATORS_HPP
+
+#include <algorithm>
+#include <stdexcept>
+
+/*
+    BigInt + BigInt
+    ---------------
+    The operand on the RHS of the addition is `num`.
+*/
+
+BigInt BigInt::operator+(const BigInt& num) const& {
+    BigInt result;  // the resultant sum
+
+    // add small values natively, unless the sum overflows
+    numericxx::i128 lhs, rhs, sum;
+    if (this->try_get_i128(lhs) and num.try_get_i128(rhs) and
+        !__builtin_add_overflow(lhs, rhs, &sum)) {
+        result.assign_i128(sum);
+        return result;
+    }
+
+    if (this->sign == num.sign) {
+        result.limbs =
+            numericxx::detail::add_magnitudes(this->limbs, num.limbs);
+        result.sign = this->sign;
+    }
+    // if the operands are of opposite signs, subtract the smaller magnitude
+    // from the larger one, which also decides the sign of the result
+    else if (numericxx::detail::compare_magnitudes(this->limbs, num.limbs) >=
+             0) {
+        result.limbs =
+            numericxx::detail::subtract_magnitudes(this->limbs, num.limbs);
+        result.sign = this->sign;
+    } else {
+        result.limbs =
+            numericxx::detail::subtract_magnitudes(num.limbs, this->limbs);
+        result.sign = num.sign;
+    }
+
+    // if the result is 0, set its sign as +
+    if (result.limbs.empty()) result.sign = '+';
+
+    return result;
+}
+
+/*
+    BigInt - BigInt
+    ---------------
+    The operand on the RHS of the subtraction is `num`.
+*/
+
+BigInt BigInt::operator-(const BigInt& num) const& {
+    BigInt result;  // the resultant difference
+
+    // subtract small values natively, unless the difference overflows
+    numericxx::i128 lhs, rhs, difference;
+    if (this->try_get_i128(lhs) and num.try_get_i128(rhs) and
+        !__builtin_sub_overflow(lhs, rhs, &difference)) {
+        result.assign_i128(difference);
+        return result;
+    }
+
+    // if the operands are of opposite signs, add the magnitudes
+    if (this->sign != num.sign) {
+        result.limbs =
+            numericxx::detail::add_magnitudes(this->limbs, num.limbs);
+        result.sign = this->sign;
+    }
+    // otherwise subtract the smaller magnitude from the larger one
+    else if (numericxx::detail::compare_magnitudes(this->limbs, num.limbs) >=
+             0) {
+        result.limbs =
+            numericxx::detail::subtract_magnitudes(this->limbs, num.limbs);
+        result.sign = this->sign;  // -larger - -smaller = -result
+    } else {
+        result.limbs =
+            numericxx::detail::subtract_magnitudes(num.limbs, this->limbs);
+        // smaller - larger = -result
+        result.sign = num.sign == '+' ? '-' : '+';
+    }
+
+    // if the result is 0, set its sign as +
+    if (result.limbs.empty()) result.sign = '+';
+
+    return result;
+}
+
+/*
+    BigInt + BigInt (rvalue operands)
+    ---------------------------------
+    The sum is accumulated into the storage of a temporary operand, choosing
+    the one with the larger buffer when both are temporaries.
+*/
+
+BigInt BigInt::operator+(const BigInt& num) && {
+    *this += num;
+
+    return std::move(*this);
+}
+
+BigInt BigInt::operator+(BigInt&& num) const& {
+    num += *this;
+
+    return std::move(num);
+}
+
+BigInt BigInt::operator+(BigInt&& num) && {
+    if (num.limbs.capacity() > limbs.capacity()) {
+        num += *this;
+        return std::move(num);
+    }
+    *this += num;
+
+    return std::move(*this);
+}
+
+/*
+    BigInt - BigInt (rvalue operands)
+    ---------------------------------
+    The difference is computed in the storage of a temporary operand, using
+    a - b = -(b - a) when only the RHS is a temporary.
+*/
+
+BigInt BigInt::operator-(const BigInt& num) && {
+    *this -= num;
+
+    return std::move(*this);
+}
+
+BigInt BigInt::operator-(BigInt&& num) const& {
+    num -= *this;
+
+    return -std::move(num);
+}
+
+BigInt BigInt::operator-(BigInt&& num) && {
+    *this -= num;
+
+    return std::move(*this);
+}
+
+/*
+    BigInt * BigInt
+    ---------------
+    Computes the product of two BigInts, using schoolbook, Karatsuba or
+    Toom-Cook multiplication depending on the size of the operands.
+    The operand on the RHS of the product is `num`.
+*/
+
+BigInt BigInt::operator*(const BigInt& num) const {
+    if (this->limbs.empty() or num.limbs.empty()) return BigInt(0);
+    if (this == &num) return square(*this);
+
+    BigInt product;
+
+    // multiply small values natively, unless the product overflows
+    numericxx::i128 lhs, rhs, small_product;
+    if (this->try_get_i128(lhs) and num.try_get_i128(rhs) and
+        !__builtin_mul_overflow(lhs, rhs, &small_product)) {
+        product.assign_i128(small_product);
+        return product;
+    }
+
+    product.limbs =
+        numericxx::detail::multiply_magnitudes(this->limbs, num.limbs);
+
+    if (this->sign == num.sign)
+        product.sign = '+';
+    else
+        product.sign = '-';
+
+    return product;
+}
+
+/*
+    BigInt / BigInt
+    ---------------
+    Computes the quotient of two BigInts, truncated towards zero.
+    The operand on the RHS of the division (the divisor) is `num`.
+*/
+
+BigInt BigInt::operator/(const BigInt& num) const {
+    return std::get<0>(divmod(*this, num));
+}
+
+/*
+    BigInt % BigInt
+    ---------------
+    Computes the modulo (remainder on division) of two BigInts.
+    The operand on the RHS of the modulo (the divisor) is `num`.
+*/
+
+BigInt BigInt::operator%(const BigInt& num) const {
+    return std::get<1>(divmod(*this, num));
+}
+
+/*
+    BigInt + Integer
+    ----------------
+*/
+
+BigInt BigInt::operator+(const long long& num) const& {
+    BigInt result = *this;
+    result += num;
+
+    return result;
+}
+
+BigInt BigInt::operator+(const long long& num) && {
+    *this += num;
+
+    return std::move(*this);
+}
+
+/*
+    Integer + BigInt
+    ----------------
+*/
+
+BigInt operator+(const long long& lhs, const BigInt& rhs) {
+    return rhs + lhs;
+}
+
+/*
+    BigInt - Integer
+    ----------------
+*/
+
+BigInt BigInt::operator-(const long long& num) const& {
+    BigInt result = *this;
+    result -= num;
+
+    return result;
+}
+
+BigInt BigInt::operator-(const long long& num) && {
+    *this -= num;
+
+    return std::move(*this);
+}
+
+/*
+    Integer - BigInt
+    ----------------
+*/
+
+BigInt operator-(const long long& lhs, const BigInt& rhs) {
+    return -(rhs - lhs);
+}
+
+/*
+    BigInt * Integer
+    ----------------
+*/
+
+BigInt BigInt::operator*(const long long& num) const {
+    BigInt result = *this;
+    result *= num;
+
+    return result;
+}
+
+/*
+    Integer * BigInt
+    ----------------
+*/
+
+BigInt operator*(const long long& lhs, const BigInt& rhs) {
+    return rhs * lhs;
+}
+
+/*
+    BigInt / Integer
+    ----------------
+*/
+
+BigInt BigInt::operator/(const long long& num) const {
+    BigInt result = *this;
+    result /= num;
+
+    return result;
+}
+
+/*
+    Integer / BigInt
+    ----------------
+*/
+
+BigInt operator/(const long long& lhs, const BigInt& rhs) {
+    return BigInt(lhs) / rhs;
+}
+
+/*
+    BigInt % Integer
+    ----------------
+*/
+
+BigInt BigInt::operator%(const long long& num) const {
+    if (num == 0) throw std::logic_error("Attempted division by zero");
+
+    BigInt result;
+    // negate in unsigned arithmetic so that LLONG_MIN does not overflow
+    numericxx::u64 magnitude = num < 0 ? -(numericxx::u64)num : num;
+    numericxx::u64 remainder = numericxx::detail::limbs_mod_1(
+        limbs.data(), limbs.size(), numericxx::detail::LimbDivisor(magnitude));
+    if (remainder) {
+        result.limbs.push_back(remainder);
+        result.sign = sign;
+    }
+
+    return result;
+}
+
+/*
+    Integer % BigInt
+    ----------------
+*/
+
+BigInt operator%(const long long& lhs, const BigInt& rhs) {
+    return BigInt(lhs) % rhs;
+}
+
+/*
+    BigInt + String
+    ---------------
+*/
+
+BigInt BigInt::operator+(const std::string& num) const& {
+    return *this + BigInt(num);
+}
+
+BigInt BigInt::operator+(const std::string& num) && {
+    *this += num;
+
+    return std::move(*this);
+}
+
+/*
+    String + BigInt
+    ---------------
+*/
+
+BigInt operator+(const std::string& lhs, const BigInt& rhs) {
+    return BigInt(lhs) + rhs;
+}
+
+/*
+    BigInt - String
+    ---------------
+*/
+
+BigInt BigInt::operator-(const std::string& num) const& {
+    return *this - BigInt(num);
+}
+
+BigInt BigInt::operator-(const std::string& num) && {
+    *this -= num;
+
+    return std::move(*this);
+}
+
+/*
+    String - BigInt
+    ---------------
+*/
+
+BigInt operator-(const std::string& lhs, const BigInt& rhs) {
+    return BigInt(lhs) - rhs;
+}
+
+/*
+    BigInt * String
+    ---------------
+*/
+
+BigInt BigInt::operator*(const std::string& num) const {
+    return *this * BigInt(num);
+}
+
+/*
+    String * BigInt
+    ---------------
+*/
+
+BigInt operator*(const std::string& lhs, const BigInt& rhs) {
+    return BigInt(lhs) * rhs;
+}
+
+/*
+    BigInt / String
+    ---------------
+*/
+
+BigInt BigInt::operator/(const std::string& num) const {
+    return *this / BigInt(num);
+}
+
+/*
+    String / BigInt
+    ---------------
+*/
+
+BigInt operator/(const std::string& lhs, const BigInt& rhs) {
+    return BigInt(lhs) / rhs;
+}
+
+/*
+    BigInt % String
+    ---------------
+*/
+
+BigInt BigInt::operator%(const std::string& num) const {
+    return *this % BigInt(num);
+}
+
+/*
+    String % BigInt
+    ---------------
+*/
+
+BigInt operator%(const std::string& lhs, const BigInt& rhs) {
+    return BigInt(lhs) % rhs;
+}
+
+#endif  // BIG_INT_BINARY_ARITHMETIC_OPERATORS_HPP
+
+/*
+    ===========================================================================
+    Arithmetic-assignment operators
+    ===========================================================================
+*/
+
+#ifndef BIG_INT_ARITHMETIC_ASSIGNMENT_OPERATORS_HPP
+#define BIG_INT_ARITHMETIC_ASSIGNMENT_OPERATORS_HPP
+
+/*
+    BigInt += BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator+=(const BigInt& num) {
+    numericxx::i128 lhs, rhs, sum;
+    if (this->try_get_i128(lhs) and num.try_get_i128(rhs) and
+        !__builtin_add_overflow(lhs, rhs, &sum)) {
+        assign_i128(sum);
+        return *this;
+    }
+
+    if (this->sign == num.sign)
+        numericxx::detail::add_magnitudes_in_place(limbs, num.limbs);
+    else if (numericxx::detail::subtract_magnitudes_in_place(limbs, num.limbs))
+        sign = num.sign;  // the magnitude of `num` was larger
+
+    if (limbs.empty()) sign = '+';
+
+    return *this;
+}
+
+/*
+    BigInt -= BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator-=(const BigInt& num) {
+    numericxx::i128 lhs, rhs, difference;
+    if (this->try_get_i128(lhs) and num.try_get_i128(rhs) and
+        !__builtin_sub_overflow(lhs, rhs, &difference)) {
+        assign_i128(difference);
+        return *this;
+    }
+
+    if (this->sign != num.sign)
+        numericxx::detail::add_magnitudes_in_place(limbs, num.limbs);
+    else if (numericxx::detail::subtract_magnitudes_in_place(limbs, num.limbs))
+        // the magnitude of `num` was larger
+        sign = num.sign == '+' ? '-' : '+';
+
+    if (limbs.empty()) sign = '+';
+
+    return *this;
+}
+
+/*
+    BigInt *= BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator*=(const BigInt& num) {
+    *this = *this * num;
+
+    return *this;
+}
+
+/*
+    BigInt /= BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator/=(const BigInt& num) {
+    *this = *this / num;
+
+    return *this;
+}
+
+/*
+    BigInt %= BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator%=(const BigInt& num) {
+    *this = *this % num;
+
+    return *this;
+}
+
+/*
+    add_limb
+    --------
+    Adds a single-limb magnitude with sign `num_sign` to this BigInt in place,
+    without building a BigInt for it.
+*/
+
+void BigInt::add_limb(numericxx::u64 num, char num_sign) {
+    if (num == 0) return;
+    if (limbs.empty()) {
+        limbs.push_back(num);
+        sign = num_sign;
+    } else if (sign == num_sign) {
+        numericxx::u64 carry = numericxx::detail::limbs_add_1(
+            limbs.data(), limbs.data(), limbs.size(), num);
+        if (carry) limbs.push_back(carry);
+    } else if (limbs.size() > 1 or limbs[0] >= num) {
+        numericxx::detail::limbs_sub_1(limbs.data(), limbs.data(), limbs.size(),
+                                       num);
+        numericxx::detail::strip_leading_zero_limbs(limbs);
+        if (limbs.empty()) sign = '+';
+    } else {
+        limbs[0] = num - limbs[0];
+        sign = num_sign;
+    }
+}
+
+/*
+    BigInt += Integer
+    -----------------
+*/
+
+BigInt& BigInt::operator+=(const long long& num) {
+    // negate in unsigned arithmetic so that LLONG_MIN does not overflow
+    add_limb(num < 0 ? -(numericxx::u64)num : num, num < 0 ? '-' : '+');
+
+    return *this;
+}
+
+/*
+    BigInt -= Integer
+    -----------------
+*/
+
+BigInt& BigInt::operator-=(const long long& num) {
+    add_limb(num < 0 ? -(numericxx::u64)num : num, num < 0 ? '+' : '-');
+
+    return *this;
+}
+
+/*
+    BigInt *= Integer
+    -----------------
+*/
+
+BigInt& BigInt::operator*=(const long long& num) {
+    if (num == 0 or limbs.empty()) {
+        limbs.clear();
+        sign = '+';
+        return *this;
+    }
+
+    numericxx::u64 magnitude = num < 0 ? -(numericxx::u64)num : num;
+    numericxx::u64 carry = numericxx::detail::limbs_mul_1(
+        limbs.data(), limbs.data(), limbs.size(), magnitude);
+    if (carry) limbs.push_back(carry);
+    if (num < 0) sign = sign == '+' ? '-' : '+';
+
+    return *this;
+}
+
+/*
+    BigInt /= Integer
+    -----------------
+*/
+
+BigInt& BigInt::operator/=(const long long& num) {
+    if (num == 0) throw std::logic_error("Attempted division by zero");
+
+    numericxx::u64 magnitude = num < 0 ? -(numericxx::u64)num : num;
+    numericxx::detail::LimbDivisor divisor(magnitude);
+    numericxx::detail::limbs_divrem_1(limbs.data(), limbs.data(), limbs.size(),
+                                      divisor);
+    numericxx::detail::strip_leading_zero_limbs(limbs);
+    if (num < 0) sign = sign == '+' ? '-' : '+';
+    if (limbs.empty()) sign = '+';
+
+    return *this;
+}
+
+/*
+    BigInt %= Integer
+    -----------------
+*/
+
+BigInt& BigInt::operator%=(const long long& num) {
+    *this = *this % num;
+
+    return *this;
+}
+
+/*
+    BigInt += String
+    ----------------
+*/
+
+BigInt& BigInt::operator+=(const std::string& num) {
+    *this = *this + BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt -= String
+    ----------------
+*/
+
+BigInt& BigInt::operator-=(const std::string& num) {
+    *this = *this - BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt *= String
+    ----------------
+*/
+
+BigInt& BigInt::operator*=(const std::string& num) {
+    *this = *this * BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt /= String
+    ----------------
+*/
+
+BigInt& BigInt::operator/=(const std::string& num) {
+    *this = *this / BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt %= String
+    ----------------
+*/
+
+BigInt& BigInt::operator%=(const std::string& num) {
+    *this = *this % BigInt(num);
+
+    return *this;
+}
+
+#endif  // BIG_INT_ARITHMETIC_ASSIGNMENT_OPERATORS_HPP
+
+/*
+    ===========================================================================
+    Increment and decrement operators
+    ===========================================================================
+*/
+
+#ifndef BIG_INT_INCREMENT_DECREMENT_OPERATORS_HPP
+#define BIG_INT_INCREMENT_DECREMENT_OPERATORS_HPP
+
+/*
+    Pre-increment
+    -------------
+    ++BigInt
+*/
+
+BigInt& BigInt::operator++() {
+    *this += 1;
+
+    return *this;
+}
+
+/*
+    Pre-decrement
+    -------------
+    --BigInt
+*/
+
+BigInt& BigInt::operator--() {
+    *this -= 1;
+
+    return *this;
+}
+
+/*
+    Post-increment
+    --------------
+    BigInt++
+*/
+
+BigInt BigInt::operator++(int) {
+    BigInt temp = *this;
+    *this += 1;
+
+    return temp;
+}
+
+/*
+    Post-decrement
+    --------------
+    BigInt--
+*/
+
+BigInt BigInt::operator--(int) {
+    BigInt temp = *this;
+    *this -= 1;
+
+    return temp;
+}
+
+#endif  // BIG_INT_INCREMENT_DECREMENT_OPERATORS_HPP
+
+/*
+    ===========================================================================
+    Bitwise operators
+    ===========================================================================
+    Bitwise operators treat a BigInt as an infinitely sign-extended two's
+    complement number, like the built-in integers do. Negative operands are
+    converted to two's complement a limb at a time, so no temporary is built
+    for them.
+*/
+
+#ifndef BIG_INT_BITWISE_OPERATORS_HPP
+#define BIG_INT_BITWISE_OPERATORS_HPP
+
+namespace numericxx::detail {
+
+/*
+    twos_complement_limb
+    --------------------
+    Returns limb `index` of the two's complement of a signed magnitude, for
+    indices visited in increasing order starting at 0. `borrow` carries the
+    state between the calls, and has to start out as 1 for negative numbers.
+*/
+
+u64 twos_complement_limb(const LimbVector& num, bool negative, size_t index,
+                         u64& borrow) {
+    u64 limb = index < num.size() ? num[index] : 0;
+    if (!negative) return limb;
+
+    u64 difference = limb - borrow;
+    borrow &= limb == 0;
+
+    return ~difference;
+}
+
+/*
+    limbs_bitwise
+    -------------
+    Applies a bitwise operation to the two's complements of two signed
+    magnitudes, and returns the magnitude of the result, whose sign is
+    `negative`.
+*/
+
+template <class Operation>
+LimbVector limbs_bitwise(const LimbVector& num1, bool negative1,
+                         const LimbVector& num2, bool negative2,
+                         bool negative, Operation operation) {
+    size_t size = std::max(num1.size(), num2.size()) + 1;
+    LimbVector result(size);
+
+    u64 borrow1 = negative1, borrow2 = negative2, carry = negative;
+    for (size_t i = 0; i < size; i++) {
+        u64 limb = operation(twos_complement_limb(num1, negative1, i, borrow1),
+                             twos_complement_limb(num2, negative2, i, borrow2));
+        if (negative) {  // negate back to a magnitude
+            limb = ~limb + carry;
+            carry &= limb == 0;
+        }
+        result[i] = limb;
+    }
+    strip_leading_zero_limbs(result);
+
+    return result;
+}
+
+}  // namespace numericxx::detail
+
+/*
+    ~BigInt
+    -------
+    Returns -BigInt - 1.
+*/
+
+BigInt BigInt::operator~() const { return -*this - 1; }
+
+/*
+    BigInt & BigInt
+    ---------------
+*/
+
+BigInt BigInt::operator&(const BigInt& num) const {
+    BigInt result;
+    bool negative = sign == '-' and num.sign == '-';
+    result.limbs = numericxx::detail::limbs_bitwise(
+        limbs, sign == '-', num.limbs, num.sign == '-', negative,
+        [](numericxx::u64 a, numericxx::u64 b) { return a & b; });
+    if (negative) result.sign = '-';
+
+    return result;
+}
+
+/*
+    BigInt | BigInt
+    ---------------
+*/
+
+BigInt BigInt::operator|(const BigInt& num) const {
+    BigInt result;
+    bool negative = sign == '-' or num.sign == '-';
+    result.limbs = numericxx::detail::limbs_bitwise(
+        limbs, sign == '-', num.limbs, num.sign == '-', negative,
+        [](numericxx::u64 a, numericxx::u64 b) { return a | b; });
+    if (negative) result.sign = '-';
+
+    return result;
+}
+
+/*
+    BigInt ^ BigInt
+    ---------------
+*/
+
+BigInt BigInt::operator^(const BigInt& num) const {
+    BigInt result;
+    bool negative = sign != num.sign;
+    result.limbs = numericxx::detail::limbs_bitwise(
+        limbs, sign == '-', num.limbs, num.sign == '-', negative,
+        [](numericxx::u64 a, numericxx::u64 b) { return a ^ b; });
+    if (negative) result.sign = '-';
+
+    return result;
+}
+
+/*
+    BigInt << Integer
+    -----------------
+    Returns BigInt * 2^shift.
+*/
+
+BigInt BigInt::operator<<(size_t shift) const {
+    BigInt result = *this;
+    result <<= shift;
+
+    return result;
+}
+
+/*
+    BigInt >> Integer
+    -----------------
+    Returns BigInt / 2^shift, rounded towards negative infinity.
+*/
+
+BigInt BigInt::operator>>(size_t shift) const {
+    BigInt result = *this;
+    result >>= shift;
+
+    return result;
+}
+
+/*
+    BigInt &= BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator&=(const BigInt& num) {
+    *this = *this & num;
+
+    return *this;
+}
+
+/*
+    BigInt |= BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator|=(const BigInt& num) {
+    *this = *this | num;
+
+    return *this;
+}
+
+/*
+    BigInt ^= BigInt
+    ----------------
+*/
+
+BigInt& BigInt::operator^=(const BigInt& num) {
+    *this = *this ^ num;
+
+    return *this;
+}
+
+/*
+    BigInt <<= Integer
+    ------------------
+    Shifts whole limbs first, then the remaining bits in place.
+*/
+
+BigInt& BigInt::operator<<=(size_t shift) {
+    if (limbs.empty()) return *this;
+
+    size_t limb_shift = shift / 64;
+    size_t size = limbs.size();
+    numericxx::detail::shift_limbs_up(limbs, limb_shift);
+    numericxx::u64 carry = numericxx::detail::limbs_lshift(
+        limbs.data() + limb_shift, limbs.data() + limb_shift, size, shift % 64);
+    if (carry) limbs.push_back(carry);
+
+    return *this;
+}
+
+/*
+    BigInt >>= Integer
+    ------------------
+    Shifts whole limbs first, then the remaining bits in place. Negative
+    numbers that lose any set bits are rounded down by adding one to their
+    magnitude.
+*/
+
+BigInt& BigInt::operator>>=(size_t shift) {
+    if (limbs.empty()) return *this;
+
+    size_t limb_shift = shift / 64;
+    unsigned bit_shift = shift % 64;
+
+    bool inexact = false;
+    if (sign == '-') {
+        size_t dropped = std::min(limb_shift, limbs.size());
+        for (size_t i = 0; i < dropped and !inexact; i++)
+            inexact = limbs[i] != 0;
+        numericxx::u64 low_bits = (numericxx::u64(1) << bit_shift) - 1;
+        if (limb_shift < limbs.size())
+            inexact |= (limbs[limb_shift] & low_bits) != 0;
+    }
+
+    numericxx::detail::shift_limbs_down(limbs, limb_shift);
+    numericxx::detail::limbs_rshift(limbs.data(), limbs.data(), limbs.size(),
+                                    bit_shift);
+    numericxx::detail::strip_leading_zero_limbs(limbs);
+
+    if (inexact)
+        add_limb(1, '-');
+    else if (limbs.empty())
+        sign = '+';
+
+    return *this;
+}
+
+/*
+    bit_length
+    ----------
+    Returns the number of bits in the magnitude of a BigInt, or 0 for zero.
+*/
+
+size_t BigInt::bit_length() const {
+    if (limbs.empty()) return 0;
+
+    return 64 * limbs.size() - __builtin_clzll(limbs.back());
+}
+
+/*
+    trailing_zeros
+    --------------
+    Returns the number of zero bits below the lowest set bit, which is the
+    same for a BigInt and its magnitude, or 0 for zero.
+*/
+
+size_t BigInt::trailing_zeros() const {
+    for (size_t i = 0; i < limbs.size(); i++)
+        if (limbs[i] != 0) return 64 * i + __builtin_ctzll(limbs[i]);
+
+    return 0;
+}
+
+/*
+    popcount
+    --------
+    Returns the number of set bits in the magnitude of a BigInt.
+    NOTE: a negative number has infinitely many set bits in two's complement,
+    so its magnitude is counted instead.
+*/
+
+size_t BigInt::popcount() const {
+    size_t count = 0;
+    for (numericxx::u64 limb : limbs) count += __builtin_popcountll(limb);
+
+    return count;
+}
+
+/*
+    test_bit
+    --------
+    Returns bit `index` of the two's complement of a BigInt.
+*/
+
+bool BigInt::test_bit(size_t index) const {
+    size_t limb_index = index / 64;
+    bool bit = limb_index < limbs.size() and
+               (limbs[limb_index] >> index % 64) & 1;
+    if (sign == '+') return bit;
+
+    // subtracting one from the magnitude flips the bits up to and including
+    // its lowest set bit, and the complement flips them all
+    return bit == (index <= trailing_zeros());
+}
+
+#endif  // BIG_INT_BITWISE_OPERATORS_HPP
+
+/*
+    ===========================================================================
+    I/O stream operators
+    ===========================================================================
+*/
+
+#ifndef BIG_INT_IO_STREAM_OPERATORS_HPP
+#define BIG_INT_IO_STREAM_OPERATORS_HPP
+
+/*
+    BigInt from input stream
+    ------------------------
+*/
+
+std::istream& operator>>(std::istream& in, BigInt& num) {
+    std::string input;
+    in >> input;
+    num = BigInt(input);  // remove sign from value and set sign, if exists
+
+    return in;
+}
+
+/*
+    BigInt to output stream
+    -----------------------
+*/
+
+std::ostream& operator<<(std::ostream& out, const BigInt& num) {
+    // format numbers that fit on the stack without allocating a string
+    char chars[128];
+    if (to_chars_size(num) <= sizeof(chars)) {
+        char* end = to_chars(chars, chars + sizeof(chars), num).ptr;
+        out << std::string_view(chars, end - chars);
+    } else {
+        out << num.to_string();
+    }
+
+    return out;
+}
+
+#endif  // BIG_INT_IO_STREAM_OPERATORS_HPP
+
+/*
+    ===========================================================================
+    Binary serialization
+    ===========================================================================
+    Versioned binary encoding of BigInts. Every value starts with a tag byte
+    holding the encoding version in its high four bits, followed by either
+    - a varint (7 bits per byte, least significant first) with the magnitude,
+      for magnitudes that fit in a limb, or
+    - a varint with the number of limbs, then the limbs themselves as 8-byte
+      little-endian words, least significant first.
+    Bit 0 of the tag is set for negative numbers and bit 1 for the limb form.
+    Readers accept only the canonical encoding written here, and BigIntView
+    refers to the limbs in place, so that a memory-mapped file can be walked
+    without copying it.
+*/
+
+#ifndef BIG_INT_SERIALIZATION_HPP
+#define BIG_INT_SERIALIZATION_HPP
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+// Version of the binary encoding written by serialize
+const unsigned BIGINT_ENCODING_VERSION = 1;
+
+namespace numericxx::detail {
+
+constexpr u8 TAG_NEGATIVE = 1;
+constexpr u8 TAG_LIMBS = 2;
+constexpr u8 TAG_FLAGS = TAG_NEGATIVE | TAG_LIMBS;
+
+/*
+    encoding_tag
+    ------------
+    Returns the tag byte starting the encoding of a number.
+*/
+
+u8 encoding_tag(bool negative, bool limb_form) {
+    u8 tag = BIGINT_ENCODING_VERSION << 4;
+    if (negative) tag |= TAG_NEGATIVE;
+    if (limb_form) tag |= TAG_LIMBS;
+
+    return tag;
+}
+
+/*
+    varint_size
+    -----------
+    Returns the number of bytes in the varint encoding of a value.
+*/
+
+size_t varint_size(u64 value) {
+    size_t size = 1;
+    while (value >>= 7) size++;
+
+    return size;
+}
+
+/*
+    write_varint
+    ------------
+    Writes the varint encoding of a value and returns the end of it.
+*/
+
+unsigned char* write_varint(unsigned char* out, u64 value) {
+    while (value >= 0x80) {
+        *out++ = (value & 0x7f) | 0x80;
+        value >>= 7;
+    }
+    *out++ = value;
+
+    return out;
+}
+
+/*
+    read_varint
+    -----------
+    Reads a varint from [in, end) and returns the end of it.
+    NOTE: truncated varints, those with redundant trailing zero bytes and
+    values not fitting in 64 bits throw an invalid_argument exception.
+*/
+
+const unsigned char* read_varint(const unsigned char* in,
+                                 const unsigned char* end, u64& value) {
+    value = 0;
+    for (unsigned shift = 0; in != end and shift < 64; shift += 7) {
+        u64 byte = *in++;
+        if (shift == 63 and byte > 1) break;  // overflows 64 bits
+        value |= (byte & 0x7f) << shift;
+        if (byte < 0x80) {
+            if (byte == 0 and shift != 0) break;  // not the shortest form
+            return in;
+        }
+    }
+
+    throw std::invalid_argument("Malformed BigInt encoding");
+}
+
+/*
+    load_limb
+    ---------
+    Reads a little-endian limb from a possibly unaligned address.
+*/
+
+u64 load_limb(const unsigned char* bytes) {
+    u64 limb;
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(&limb, bytes, sizeof(limb));
+    } else {
+        limb = 0;
+        for (size_t i = 0; i < sizeof(limb); i++)
+            limb |= u64(bytes[i]) << 8 * i;
+    }
+
+    return limb;
+}
+
+/*
+    store_limbs
+    -----------
+    Writes limbs as little-endian words and returns the end of them.
+*/
+
+unsigned char* store_limbs(unsigned char* out, const u64* limbs, size_t size) {
+    if constexpr (std::endian::native == std::endian::little) {
+        if (size != 0) std::memcpy(out, limbs, size * sizeof(u64));
+        return out + size * sizeof(u64);
+    }
+
+    for (size_t i = 0; i < size; i++)
+        for (size_t j = 0; j < sizeof(u64); j++) *out++ = limbs[i] >> 8 * j;
+
+    return out;
+}
+
+}  // namespace numericxx::detail
+
+/*
+    serialized_size
+    ---------------
+    Returns the number of bytes serialize writes for a BigInt.
+*/
+
+size_t serialized_size(const BigInt& num) {
+    if (num.limbs.size() <= 1)
+        return 1 + numericxx::detail::varint_size(
+                       num.limbs.empty() ? 0 : num.limbs[0]);
+
+    return 1 + numericxx::detail::varint_size(num.limbs.size()) +
+           num.limbs.size() * sizeof(numericxx::u64);
+}
+
+/*
+    serialize
+    ---------
+    Writes the binary encoding of a BigInt to `out` and returns the end of it.
+    NOTE: there must be room for serialized_size(num) bytes.
+*/
+
+unsigned char* serialize(unsigned char* out, const BigInt& num) {
+    bool limb_form = num.limbs.size() > 1;
+    *out++ = numericxx::detail::encoding_tag(num.sign == '-', limb_form);
+
+    if (!limb_form)
+        return numericxx::detail::write_varint(
+            out, num.limbs.empty() ? 0 : num.limbs[0]);
+
+    out = numericxx::detail::write_varint(out, num.limbs.size());
+
+    return numericxx::detail::store_limbs(out, num.limbs.data(),
+                                          num.limbs.size());
+}
+
+/*
+    serialize (output stream)
+    -------------------------
+    Writes the binary encoding of a BigInt to an output stream.
+*/
+
+std::ostream& serialize(std::ostream& out, const BigInt& num) {
+    unsigned char bytes[16];  // holds a tag and a varint, or a limb
+    if (num.limbs.size() <= 1)
+        return out.write(reinterpret_cast<char*>(bytes),
+                         serialize(bytes, num) - bytes);
+
+    bytes[0] = numericxx::detail::encoding_tag(num.sign == '-', true);
+    unsigned char* end =
+        numericxx::detail::write_varint(bytes + 1, num.limbs.size());
+    out.write(reinterpret_cast<char*>(bytes), end - bytes);
+
+    // the limbs are written as they are stored where the byte order matches
+    if constexpr (std::endian::native == std::endian::little)
+        return out.write(reinterpret_cast<const char*>(num.limbs.data()),
+                         num.limbs.size() * sizeof(numericxx::u64));
+
+    for (numericxx::u64 limb : num.limbs) {
+        numericxx::detail::store_limbs(bytes, &limb, 1);
+        out.write(reinterpret_cast<char*>(bytes), sizeof(limb));
+    }
+
+    return out;
+}
+
+/*
+    BigIntView
+    ----------
+    A read-only view of a serialized BigInt, referring to its limbs where
+    they are stored. The view is only valid as long as the serialized bytes
+    are.
+*/
+
+class BigIntView {
+    const unsigned char* limb_bytes;  // null for values held in `small`
+    size_t num_limbs;
+    numericxx::u64 small;
+    bool negative;
+
+   public:
+    BigIntView() : limb_bytes(nullptr), num_limbs(0), small(0),
+                   negative(false) {}
+
+    // Reads the view from [first, last), returning the end of the encoding:
+    const unsigned char* read(const unsigned char* first,
+                              const unsigned char* last);
+
+    size_t size() const { return num_limbs; }  // number of limbs
+    bool is_negative() const { return negative; }
+    numericxx::u64 limb(size_t index) const {
+        return limb_bytes ? numericxx::detail::load_limb(
+                                limb_bytes + sizeof(numericxx::u64) * index)
+                          : small;
+    }
+
+    BigInt to_bigint() const;
+};
+
+/*
+    BigIntView::read
+    ----------------
+    Reads a view of the BigInt encoded at the start of [first, last) and
+    returns the end of its encoding.
+    NOTE: malformed or truncated encodings, those of other versions and
+    non-canonical ones (leading zero limbs, negative zero) throw an
+    invalid_argument exception.
+*/
+
+const unsigned char* BigIntView::read(const unsigned char* first,
+                                      const unsigned char* last) {
+    if (first == last) throw std::invalid_argument("Truncated BigInt encoding");
+    numericxx::u8 tag = *first++;
+    if (tag >> 4 != BIGINT_ENCODING_VERSION)
+        throw std::invalid_argument("Unsupported BigInt encoding version " +
+                                    std::to_string(tag >> 4));
+    if (tag & 0x0f & ~numericxx::detail::TAG_FLAGS)
+        throw std::invalid_argument("Malformed BigInt encoding");
+
+    numericxx::u64 value;
+    first = numericxx::detail::read_varint(first, last, value);
+    bool is_negative = tag & numericxx::detail::TAG_NEGATIVE;
+
+    if (!(tag & numericxx::detail::TAG_LIMBS)) {
+        if (is_negative and value == 0)
+            throw std::invalid_argument("Malformed BigInt encoding");
+        limb_bytes = nullptr;
+        num_limbs = value != 0;
+        small = value;
+        negative = is_negative;
+        return first;
+    }
+
+    if (value > size_t(last - first) / sizeof(numericxx::u64))
+        throw std::invalid_argument("Truncated BigInt encoding");
+    const unsigned char* end = first + value * sizeof(numericxx::u64);
+    // magnitudes of at most one limb have to use the varint form
+    if (value <= 1 or
+        numericxx::detail::load_limb(end - sizeof(numericxx::u64)) == 0)
+        throw std::invalid_argument("Malformed BigInt encoding");
+
+    limb_bytes = first;
+    num_limbs = value;
+    small = 0;
+    negative = is_negative;
+
+    return end;
+}
+
+/*
+    BigIntView::to_bigint
+    ---------------------
+    Copies the viewed value into a BigInt.
+*/
+
+BigInt BigIntView::to_bigint() const {
+    BigInt num;
+    num.limbs.resize(num_limbs);
+    if (limb_bytes and std::endian::native == std::endian::little)
+        std::memcpy(num.limbs.data(), limb_bytes,
+                    num_limbs * sizeof(numericxx::u64));
+    else
+        for (size_t i = 0; i < num_limbs; i++) num.limbs[i] = limb(i);
+    if (negative) num.sign = '-';
+
+    return num;
+}
+
+/*
+    deserialize
+    -----------
+    Reads the BigInt encoded at the start of [first, last) into `num` and
+    returns the end of its encoding.
+    NOTE: invalid encodings throw as BigIntView::read does, leaving `num`
+    unchanged.
+*/
+
+const unsigned char* deserialize(const unsigned char* first,
+                                 const unsigned char* last, BigInt& num) {
+    BigIntView view;
+    const unsigned char* end = view.read(first, last);
+    num = view.to_bigint();
+
+    return end;
+}
+
+/*
+    BigIntReader
+    ------------
+    Reads consecutive serialized BigInts from a block of memory, such as a
+    memory-mapped file, either as BigInts or as views into the block.
+*/
+
+class BigIntReader {
+    const unsigned char* position;
+    const unsigned char* end;
+
+   public:
+    BigIntReader(const void* data, size_t size)
+        : position(static_cast<const unsigned char*>(data)),
+          end(position + size) {}
+
+    bool at_end() const { return position == end; }
+    size_t remaining() const { return end - position; }
+
+    BigInt read() {
+        BigInt num;
+        position = deserialize(position, end, num);
+        return num;
+    }
+
+    BigIntView read_view() {
+        BigIntView view;
+        position = view.read(position, end);
+        return view;
+    }
+};
+
+#endif  // BIG_INT_SERIALIZATION_HPP
+
+/*
+    ===========================================================================
+    Lazy expressions
+    ===========================================================================
+    Opt-in expression templates. Wrapping a BigInt in `lazy` makes the
+    arithmetic it takes part in build an expression instead of a value:
+
+        BigInt result = lazy(a) * b - lazy(c) * d + e;
+
+    Sums and differences are evaluated by adding each term in place into a
+    single result reserved for the size of the whole expression, and lazy
+    products within them are accumulated with addmul and submul, so that no
+    such term becomes a BigInt of its own. Only operators with a lazy operand
+    are deferred: a plain `c * d` is still an eager BigInt temporary, and
+    factors that are themselves sums are evaluated into temporaries before
+    being multiplied. Assigning an expression to an existing BigInt evaluates
+    it into that BigInt's storage, so that `r = lazy(r) + lazy(a) * b` adds
+    the product to `r` in place.
+    NOTE: expressions refer to their operands, so they must be evaluated
+    within the full expression that builds them, as in the example above.
+*/
+
+#ifndef BIG_INT_LAZY_EXPRESSIONS_HPP
+#define BIG_INT_LAZY_EXPRESSIONS_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+
+template <class Expression>
+BigInt& evaluate_into(BigInt&, const Expression&);
+
+namespace numericxx::detail {
+
+/*
+    LazyNode
+    --------
+    Base of all expression nodes, converting them to the BigInt they stand
+    for.
+*/
+
+template <class Node>
+struct LazyNode {
+    operator BigInt() const {
+        BigInt result;
+        evaluate_into(result, static_cast<const Node&>(*this));
+        return result;
+    }
+};
+
+template <class T>
+concept LazyExpression =
+    std::derived_from<std::remove_cvref_t<T>, LazyNode<std::remove_cvref_t<T>>>;
+
+/*
+    LazyTerm, LazyInteger
+    ---------------------
+    Leaves of an expression: a reference to a BigInt and an integer held by
+    value. Every node has
+    - `bits`, an upper bound on the bit length of its value,
+    - `operand`, its value as the operand of a product,
+    - `accumulate`, adding its value to or subtracting it from `acc`,
+    - `refers_to`, whether `num` is one of its leaves,
+    - `accumulate_onto`, which, for an expression of the form `acc + ...`,
+      adds the rest to `acc` in place and returns true.
+*/
+
+struct LazyTerm : LazyNode<LazyTerm> {
+    const BigInt& value;
+
+    explicit LazyTerm(const BigInt& value) : value(value) {}
+
+    size_t bits() const { return value.bit_length(); }
+    const BigInt& operand() const { return value; }
+    void accumulate(BigInt& acc, bool negate) const {
+        if (negate)
+            acc -= value;
+        else
+            acc += value;
+    }
+    bool refers_to(const BigInt& num) const { return &value == &num; }
+    bool accumulate_onto(BigInt& acc) const { return &value == &acc; }
+};
+
+struct LazyInteger : LazyNode<LazyInteger> {
+    long long value;
+
+    explicit LazyInteger(long long value) : value(value) {}
+
+    size_t bits() const { return 64; }
+    long long operand() const { return value; }
+    void accumulate(BigInt& acc, bool negate) const {
+        if (negate)
+            acc -= value;
+        else
+            acc += value;
+    }
+    bool refers_to(const BigInt&) const { return false; }
+    bool accumulate_onto(BigInt&) const { return false; }
+};
+
+/*
+    LazySum
+    -------
+    The sum, or the difference, of two expressions.
+*/
+
+template <class Left, class Right, bool Subtract>
+struct LazySum : LazyNode<LazySum<Left, Right, Subtract>> {
+    Left left;
+    Right right;
+
+    LazySum(const Left& left, const Right& right) : left(left), right(right) {}
+
+    size_t bits() const { return std::max(left.bits(), right.bits()) + 1; }
+    BigInt operand() const { return *this; }
+    void accumulate(BigInt& acc, bool negate) const {
+        left.accumulate(acc, negate);
+        right.accumulate(acc, negate != Subtract);
+    }
+    bool refers_to(const BigInt& num) const {
+        return left.refers_to(num) or right.refers_to(num);
+    }
+    bool accumulate_onto(BigInt& acc) const {
+        // nothing is added unless the whole expression qualifies
+        if (right.refers_to(acc) or !left.accumulate_onto(acc)) return false;
+
+        right.accumulate(acc, Subtract);
+        return true;
+    }
+};
+
+/*
+    LazyNegation
+    ------------
+    The negation of an expression.
+*/
+
+template <class Operand>
+struct LazyNegation : LazyNode<LazyNegation<Operand>> {
+    Operand operand_;
+
+    explicit LazyNegation(const Operand& operand) : operand_(operand) {}
+
+    size_t bits() const { return operand_.bits(); }
+    BigInt operand() const { return *this; }
+    void accumulate(BigInt& acc, bool negate) const {
+        operand_.accumulate(acc, !negate);
+    }
+    bool refers_to(const BigInt& num) const { return operand_.refers_to(num); }
+    bool accumulate_onto(BigInt&) const { return false; }
+};
+
+/*
+    LazyProduct
+    -----------
+    The product of two expressions, accumulated with addmul or submul.
+*/
+
+template <class Left, class Right>
+struct LazyProduct : LazyNode<LazyProduct<Left, Right>> {
+    Left left;
+    Right right;
+
+    LazyProduct(const Left& left, const Right& right)
+        : left(left), right(right) {}
+
+    size_t bits() const { return left.bits() + right.bits(); }
+    BigInt operand() const { return *this; }
+    void accumulate(BigInt& acc, bool negate) const {
+        // leaves are used where they are, other factors are evaluated first
+        const auto& factor1 = left.operand();
+        const auto& factor2 = right.operand();
+
+        if constexpr (std::is_same_v<std::decay_t<decltype(factor1)>,
+                                     long long>)
+            accumulate_product(acc, factor2, factor1, negate);
+        else
+            accumulate_product(acc, factor1, factor2, negate);
+    }
+    bool refers_to(const BigInt& num) const {
+        return left.refers_to(num) or right.refers_to(num);
+    }
+    bool accumulate_onto(BigInt&) const { return false; }
+
+   private:
+    template <class Factor>
+    static void accumulate_product(BigInt& acc, const BigInt& factor1,
+                                   const Factor& factor2, bool negate) {
+        if (negate)
+            submul(acc, factor1, factor2);
+        else
+            addmul(acc, factor1, factor2);
+    }
+    static void accumulate_product(BigInt& acc, long long factor1,
+                                   long long factor2, bool negate) {
+        accumulate_product(acc, BigInt(factor1), factor2, negate);
+    }
+};
+
+/*
+    as_lazy
+    -------
+    Turns an operand of a lazy operator into an expression node.
+*/
+
+LazyTerm as_lazy(const BigInt& num) { return LazyTerm(num); }
+
+LazyInteger as_lazy(long long num) { return LazyInteger(num); }
+
+template <LazyExpression Expression>
+const Expression& as_lazy(const Expression& expression) {
+    return expression;
+}
+
+template <class T>
+concept LazyOperand = LazyExpression<T> or
+                      std::same_as<std::remove_cvref_t<T>, BigInt> or
+                      std::integral<std::remove_cvref_t<T>>;
+
+template <class Left, class Right>
+concept LazyOperands = (LazyExpression<Left> or LazyExpression<Right>) and
+                       LazyOperand<Left> and LazyOperand<Right>;
+
+template <class T>
+using LazyNodeOf = std::remove_cvref_t<decltype(as_lazy(std::declval<T>()))>;
+
+/*
+    Lazy operators
+    --------------
+    Build expression nodes whenever one of the operands is an expression.
+*/
+
+template <class Left, class Right>
+    requires LazyOperands<Left, Right>
+LazySum<LazyNodeOf<Left>, LazyNodeOf<Right>, false> operator+(
+    const Left& left, const Right& right) {
+    return {as_lazy(left), as_lazy(right)};
+}
+
+template <class Left, class Right>
+    requires LazyOperands<Left, Right>
+LazySum<LazyNodeOf<Left>, LazyNodeOf<Right>, true> operator-(
+    const Left& left, const Right& right) {
+    return {as_lazy(left), as_lazy(right)};
+}
+
+template <class Left, class Right>
+    requires LazyOperands<Left, Right>
+LazyProduct<LazyNodeOf<Left>, LazyNodeOf<Right>> operator*(
+    const Left& left, const Right& right) {
+    return {as_lazy(left), as_lazy(right)};
+}
+
+template <LazyExpression Operand>
+LazyNegation<Operand> operator-(const Operand& operand) {
+    return LazyNegation<Operand>(operand);
+}
+
+}  // namespace numericxx::detail
+
+/*
+    lazy
+    ----
+    Starts a lazy expression with a BigInt, which must outlive it.
+*/
+
+numericxx::detail::LazyTerm lazy(const BigInt& num) {
+    return numericxx::detail::LazyTerm(num);
+}
+
+numericxx::detail::LazyTerm lazy(const BigInt&& num) = delete;
+
+/*
+    evaluate_into
+    -------------
+    Evaluates a lazy expression into `result`, reusing its storage. Updates
+    of the form `result = result + ...` add the other terms to it in place;
+    other expressions that refer to `result` are evaluated aside first.
+*/
+
+template <class Expression>
+BigInt& evaluate_into(BigInt& result, const Expression& expression) {
+    if (expression.accumulate_onto(result)) return result;
+    if (expression.refers_to(result)) {
+        BigInt value;
+        evaluate_into(value, expression);
+        return result = std::move(value);
+    }
+
+    result.limbs.clear();
+    result.sign = '+';
+    result.limbs.reserve((expression.bits() + 63) / 64 + 1);
+    expression.accumulate(result, false);
+
+    return result;
+}
+
+/*
+    BigInt = lazy expression
+    ------------------------
+    Evaluates the expression with `evaluate_into`, reusing the storage of this
+    BigInt instead of converting the expression to a temporary first.
+*/
+
+template <class Node>
+BigInt& BigInt::operator=(
+    const numericxx::detail::LazyNode<Node>& expression) {
+    return evaluate_into(*this, static_cast<const Node&>(expression));
+}
+
+#endif  // BIG_INT_LAZY_EXPRESSIONS_HPP
+
+/*
+    ===========================================================================
+    Modular arithmetic
+    ===========================================================================
+    Arithmetic modulo a fixed BigInt modulus that avoids dividing by it on
+    every operation.
+*/
+
+#ifndef BIG_INT_MODULAR_ARITHMETIC_HPP
+#define BIG_INT_MODULAR_ARITHMETIC_HPP
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace numericxx::detail {
+
+/*
+    limbs_redc
+    ----------
+    Montgomery reduction of the 2n-limb number `num` < mod * B^n, writing
+    num * B^-n mod `mod` to the n limbs of `result`. Each step adds the
+    multiple of the modulus that clears the lowest remaining limb of `num`,
+    using `inverse` = -mod^-1 mod B, so that the reduction costs about as much
+    as a schoolbook multiplication by a single row per limb and no division.
+    NOTE: overwrites `num`.
+*/
+
+void limbs_redc(u64* result, u64* num, const u64* mod, size_t n, u64 inverse) {
+    u64 overflow = 0;  // carry out of the top limb of `num`
+    for (size_t i = 0; i < n; i++) {
+        u64 carry = limbs_addmul_1(num + i, mod, n, num[i] * inverse);
+        for (size_t j = i + n; carry and j < 2 * n; j++) {
+            num[j] += carry;
+            carry = num[j] < carry;
+        }
+        overflow += carry;
+    }
+
+    // the reduced value is below 2 * mod
+    if (overflow or limbs_cmp(num + n, n, mod, n) >= 0)
+        limbs_sub(result, num + n, n, mod, n);
+    else
+        std::copy(num + n, num + 2 * n, result);
+}
+
+/*
+    limbs_redc_mul
+    --------------
+    Montgomery reduction by multiplication, for moduli from
+    NUMERICXX_BIGINT_REDC_THRESHOLD limbs up: with `inverse` = -mod^-1 mod B^n,
+    q = num * inverse mod B^n makes num + q * mod divisible by B^n, which
+    takes two multiplications instead of the n rows of `limbs_redc`.
+    NOTE: overwrites `num`.
+*/
+
+void limbs_redc_mul(u64* result, u64* num, const u64* mod, size_t n,
+                    const u64* inverse) {
+    ScratchFrame scratch;
+    u64* q = scratch.allocate(2 * n);
+    u64* multiple = scratch.allocate(2 * n);
+    limbs_mul(q, num, n, inverse, n);
+    limbs_mul(multiple, q, n, mod, n);
+    u64 overflow = limbs_add(num, num, 2 * n, multiple, 2 * n);
+
+    // the reduced value is below 2 * mod
+    if (overflow or limbs_cmp(num + n, n, mod, n) >= 0)
+        limbs_sub(result, num + n, n, mod, n);
+    else
+        std::copy(num + n, num + 2 * n, result);
+}
+
+/*
+    inverse_mod_base_power
+    ----------------------
+    Returns the inverse of the odd n-limb number `num` modulo B^n, by Newton's
+    iteration x' = x * (2 - num * x), which doubles the number of correct
+    limbs of x at each step. As num * x = 1 + B^p * f modulo B^(2p) when x is
+    correct to p limbs, the step only has to write the limbs of -x * f above
+    those of x.
+*/
+
+LimbVector inverse_mod_base_power(const u64* num, size_t n) {
+    LimbVector inverse(n);
+    inverse[0] = inverse_mod_word(num[0]);
+
+    ScratchFrame scratch;
+    u64* product = scratch.allocate(2 * n);
+    u64* correction = scratch.allocate(2 * n);
+    for (size_t p = 1; p < n; p *= 2) {
+        size_t extra = std::min(p, n - p);
+        limbs_mul(product, num, p + extra, inverse.data(), p);
+        limbs_mul(correction, inverse.data(), extra, product + p, extra);
+        for (size_t i = 0; i < extra; i++) inverse[p + i] = ~correction[i];
+        limbs_add_1(inverse.data() + p, inverse.data() + p, extra, 1);
+    }
+
+    return inverse;
+}
+
+/*
+    limbs_mul_high
+    --------------
+    Schoolbook multiplication of two `size`-limb numbers that skips the
+    columns of partial products below limb `skip`, which leaves the limbs
+    from `skip` + 1 up short of the full product by less than `size` + 1
+    units of limb `skip` + 1.
+    NOTE: `result` must have room for `2 * size` limbs and must not overlap
+    either operand.
+*/
+
+void limbs_mul_high(u64* result, const u64* num1, const u64* num2, size_t size,
+                    size_t skip) {
+    std::fill(result, result + 2 * size, 0);
+    for (size_t i = 0; i < size; i++) {
+        size_t first = i < skip ? skip - i : 0;
+        result[i + size] = limbs_addmul_1(result + i + first, num2 + first,
+                                          size - first, num1[i]);
+    }
+}
+
+/*
+    limbs_mul_low
+    -------------
+    Schoolbook multiplication of two `size`-limb numbers modulo B^length,
+    writing the `length` low limbs of the product.
+    NOTE: expects `size <= length <= 2 * size`; `result` must not overlap
+    either operand.
+*/
+
+void limbs_mul_low(u64* result, const u64* num1, const u64* num2, size_t size,
+                   size_t length) {
+    std::fill(result, result + length, 0);
+    for (size_t i = 0; i < size and i < length; i++) {
+        size_t row = std::min(size, length - i);
+        u64 carry = limbs_addmul_1(result + i, num2, row, num1[i]);
+        if (i + row < length) result[i + row] += carry;
+    }
+}
+
+/*
+    limbs_mod_barrett
+    -----------------
+    Barrett reduction of the `size`-limb number `num` by the normalised n-limb
+    divisor, writing the n remainder limbs to `remainder`. `reciprocal` holds
+    the n + 1 limbs of floor(B^(2n) / divisor). Like long division, each step
+    reduces a window of [n limbs of `num`, remainder so far], estimating its
+    quotient as in `limbs_div_2n_1n_newton` and subtracting its multiple of
+    the divisor, so that the work is a few multiplications per step.
+    NOTE: numbers below divisor * B^n take a single step.
+*/
+
+void limbs_mod_barrett(u64* remainder, const u64* num, size_t size,
+                       const u64* divisor, size_t n, const u64* reciprocal) {
+    ScratchFrame scratch;
+    u64* window = scratch.allocate(2 * n);
+    u64* product = scratch.allocate(2 * n + 2);
+    u64* multiple = scratch.allocate(2 * n);
+
+    // the top block starts the remainder off unless it is not below the
+    // divisor, in which case it is reduced like the others
+    size_t blocks = (size + n - 1) / n;
+    std::fill(remainder, remainder + n, 0);
+    std::copy(num + (blocks - 1) * n, num + size, remainder);
+    if (limbs_cmp(remainder, n, divisor, n) < 0)
+        blocks--;
+    else
+        std::fill(remainder, remainder + n, 0);
+
+    for (size_t i = blocks; i-- > 0;) {
+        size_t block_size = std::min(n, size - i * n);
+        std::copy(num + i * n, num + i * n + block_size, window);
+        std::fill(window + block_size, window + n, 0);
+        std::copy(remainder, remainder + n, window + n);
+
+        // the estimate is below B^n and at most a few units too small, also
+        // when the columns of the products that cannot affect it are skipped
+        if (n < NUMERICXX_BIGINT_KARATSUBA_THRESHOLD) {
+            limbs_mul_high(product, window + n - 1, reciprocal, n + 1, n - 1);
+            limbs_mul_low(multiple, product + n + 1, divisor, n, n + 1);
+        } else {
+            limbs_mul(product, window + n - 1, n + 1, reciprocal, n + 1);
+            limbs_mul(multiple, product + n + 1, n, divisor, n);
+        }
+
+        // the difference is below 4 * divisor, so it fits in n + 1 limbs
+        u64 high = window[n] - multiple[n] -
+                   limbs_sub(remainder, window, n, multiple, n);
+        while (high or limbs_cmp(remainder, n, divisor, n) >= 0)
+            high -= limbs_sub(remainder, remainder, n, divisor, n);
+    }
+}
+
+}  // namespace numericxx::detail
+
+/*
+    MontgomeryContext<BigInt>
+    -------------------------
+    Montgomery arithmetic modulo a positive odd BigInt of n limbs, with
+    R = 2^(64n). Products are computed with the usual multiplication
+    algorithms and then reduced with `limbs_redc`, or with `limbs_redc_mul`
+    for moduli from NUMERICXX_BIGINT_REDC_THRESHOLD limbs up.
+    NOTE: `mul`, `add`, `sub` and `from_montgomery` expect operands in
+    Montgomery form, which are non-negative and below the modulus.
+*/
+
+template <>
+class numericxx::MontgomeryContext<BigInt> {
+    BigInt mod;
+    numericxx::u64 inverse;  // -mod^-1 mod 2^64
+    BigInt r_mod;            // R mod mod
+    BigInt r_squared;        // R^2 mod mod
+    // -mod^-1 mod R, only for moduli reduced by multiplication
+    numericxx::detail::LimbVector long_inverse;
+
+    // Reduces the 2n limbs at `num`, overwriting them:
+    BigInt reduce(numericxx::u64* num) const;
+
+   public:
+    using value_type = BigInt;
+
+    explicit MontgomeryContext(const BigInt& modulus);
+
+    const BigInt& modulus() const { return mod; }
+    const BigInt& one() const { return r_mod; }  // Montgomery form of 1
+
+    BigInt to_montgomery(const BigInt&) const;
+    BigInt from_montgomery(const BigInt&) const;
+    BigInt mul(const BigInt&, const BigInt&) const;
+    BigInt add(const BigInt&, const BigInt&) const;
+    BigInt sub(const BigInt&, const BigInt&) const;
+};
+
+/*
+    MontgomeryContext<BigInt>::MontgomeryContext
+    --------------------------------------------
+    Precomputes the constants for the given modulus.
+    NOTE: throws an invalid_argument exception if the modulus is not positive
+    and odd.
+*/
+
+numericxx::MontgomeryContext<BigInt>::MontgomeryContext(const BigInt& modulus)
+    : mod(modulus) {
+    if (mod.sign == '-' or mod.limbs.empty() or mod.limbs[0] % 2 == 0)
+        throw std::invalid_argument("Montgomery modulus must be positive and "
+                                    "odd");
+
+    size_t n = mod.limbs.size();
+    inverse = 0 - numericxx::detail::inverse_mod_word(mod.limbs[0]);
+    r_mod = (BigInt(1) << 64 * n) % mod;
+    r_squared = (r_mod * r_mod) % mod;
+
+    if (n >= NUMERICXX_BIGINT_REDC_THRESHOLD) {
+        long_inverse =
+            numericxx::detail::inverse_mod_base_power(mod.limbs.data(), n);
+        for (numericxx::u64& limb : long_inverse) limb = ~limb;
+        numericxx::detail::limbs_add_1(long_inverse.data(),
+                                       long_inverse.data(), n, 1);
+    }
+}
+
+/*
+    MontgomeryContext<BigInt>::reduce
+    ---------------------------------
+    Returns num * R^-1 mod m for the 2n-limb number `num` < m * R.
+*/
+
+BigInt numericxx::MontgomeryContext<BigInt>::reduce(
+    numericxx::u64* num) const {
+    size_t n = mod.limbs.size();
+    BigInt result;
+    result.limbs.resize(n);
+    if (long_inverse.empty())
+        numericxx::detail::limbs_redc(result.limbs.data(), num,
+                                      mod.limbs.data(), n, inverse);
+    else
+        numericxx::detail::limbs_redc_mul(result.limbs.data(), num,
+                                          mod.limbs.data(), n,
+                                          long_inverse.data());
+    numericxx::detail::strip_leading_zero_limbs(result.limbs);
+
+    return result;
+}
+
+/*
+    MontgomeryContext<BigInt>::to_montgomery
+    ----------------------------------------
+    Returns the Montgomery form of any BigInt, which costs one division to
+    bring it below the modulus.
+*/
+
+BigInt numericxx::MontgomeryContext<BigInt>::to_montgomery(
+    const BigInt& num) const {
+    BigInt residue = num % mod;
+    if (residue.sign == '-') residue += mod;
+
+    return mul(residue, r_squared);
+}
+
+/*
+    MontgomeryContext<BigInt>::from_montgomery
+    ------------------------------------------
+    Returns the value of a number in Montgomery form.
+*/
+
+BigInt numericxx::MontgomeryContext<BigInt>::from_montgomery(
+    const BigInt& num) const {
+    size_t n = mod.limbs.size();
+    numericxx::detail::ScratchFrame scratch;
+    numericxx::u64* padded = scratch.allocate(2 * n);
+    std::copy(num.limbs.begin(), num.limbs.end(), padded);
+    std::fill(padded + num.limbs.size(), padded + 2 * n, 0);
+
+    return reduce(padded);
+}
+
+/*
+    MontgomeryContext<BigInt>::mul
+    ------------------------------
+    Returns the Montgomery form of the product of two numbers in Montgomery
+    form. Passing the same number twice squares it.
+*/
+
+BigInt numericxx::MontgomeryContext<BigInt>::mul(const BigInt& num1,
+                                                 const BigInt& num2) const {
+    if (num1.limbs.empty() or num2.limbs.empty()) return BigInt();
+
+    size_t n = mod.limbs.size();
+    size_t size1 = num1.limbs.size(), size2 = num2.limbs.size();
+    numericxx::detail::ScratchFrame scratch;
+    numericxx::u64* product = scratch.allocate(2 * n);
+    numericxx::detail::limbs_mul(product, num1.limbs.data(), size1,
+                                 num2.limbs.data(), size2);
+    std::fill(product + size1 + size2, product + 2 * n, 0);
+
+    return reduce(product);
+}
+
+/*
+    MontgomeryContext<BigInt>::add
+    ------------------------------
+    Returns the sum of two numbers modulo the modulus.
+*/
+
+BigInt numericxx::MontgomeryContext<BigInt>::add(const BigInt& num1,
+                                                 const BigInt& num2) const {
+    BigInt sum = num1 + num2;
+    if (sum >= mod) sum -= mod;
+
+    return sum;
+}
+
+/*
+    MontgomeryContext<BigInt>::sub
+    ------------------------------
+    Returns the difference of two numbers modulo the modulus.
+*/
+
+BigInt numericxx::MontgomeryContext<BigInt>::sub(const BigInt& num1,
+                                                 const BigInt& num2) const {
+    BigInt difference = num1 - num2;
+    if (difference.sign == '-') difference += mod;
+
+    return difference;
+}
+
+/*
+    BarrettReducer
+    --------------
+    Reduces numbers by a fixed positive BigInt modulus using a reciprocal of
+    it computed once, so that each reduction costs a few multiplications
+    instead of a division. Inputs below modulus * 2^(64n), for an n-limb
+    modulus, which includes every product of two residues, take a single
+    step; larger ones take one step per n limbs.
+    NOTE: results lie in [0, modulus) for negative inputs as well, unlike
+    those of operator%.
+*/
+
+class BarrettReducer {
+    BigInt mod;
+    numericxx::detail::LimbVector divisor;     // modulus, normalised
+    numericxx::detail::LimbVector reciprocal;  // floor(B^(2n) / divisor)
+    unsigned shift;                            // normalising shift of mod
+
+   public:
+    explicit BarrettReducer(const BigInt& modulus);
+
+    const BigInt& modulus() const { return mod; }
+
+    BigInt reduce(const BigInt&) const;
+    BigInt mul(const BigInt&, const BigInt&) const;  // product mod modulus
+
+    // Reduces each of [first, last) into `result`, returning its end:
+    template <class InputIt, class OutputIt>
+    OutputIt reduce(InputIt first, InputIt last, OutputIt result) const {
+        for (; first != last; ++first, ++result) *result = reduce(*first);
+        return result;
+    }
+};
+
+/*
+    BarrettReducer::BarrettReducer
+    ------------------------------
+    Precomputes the normalised modulus and its reciprocal.
+    NOTE: throws an invalid_argument exception if the modulus is not positive.
+*/
+
+BarrettReducer::BarrettReducer(const BigInt& modulus) : mod(modulus) {
+    if (mod.sign == '-' or mod.limbs.empty())
+        throw std::invalid_argument("Barrett modulus must be positive");
+
+    size_t n = mod.limbs.size();
+    shift = __builtin_clzll(mod.limbs.back());
+    divisor.resize(n);
+    numericxx::detail::limbs_lshift(divisor.data(), mod.limbs.data(), n,
+                                    shift);
+    reciprocal.resize(n + 1);
+    numericxx::detail::limbs_reciprocal(reciprocal.data(), divisor.data(), n);
+}
+
+/*
+    BarrettReducer::reduce
+    ----------------------
+    Returns the residue of any BigInt, in [0, modulus).
+*/
+
+BigInt BarrettReducer::reduce(const BigInt& num) const {
+    BigInt result;
+    if (numericxx::detail::compare_magnitudes(num.limbs, mod.limbs) < 0) {
+        result.limbs = num.limbs;
+    } else {
+        // shift the number as far as the divisor, reduce, and shift back
+        size_t n = divisor.size(), size = num.limbs.size();
+        numericxx::detail::ScratchFrame scratch;
+        numericxx::u64* shifted = scratch.allocate(size + 1);
+        shifted[size] = numericxx::detail::limbs_lshift(
+            shifted, num.limbs.data(), size, shift);
+        if (shifted[size]) size++;
+
+        result.limbs.resize(n);
+        numericxx::detail::limbs_mod_barrett(result.limbs.data(), shifted, size,
+                                             divisor.data(), n,
+                                             reciprocal.data());
+        numericxx::detail::limbs_rshift(result.limbs.data(),
+                                        result.limbs.data(), n, shift);
+        numericxx::detail::strip_leading_zero_limbs(result.limbs);
+    }
+
+    if (num.sign == '-' and not result.limbs.empty())
+        numericxx::detail::subtract_magnitudes_in_place(result.limbs,
+                                                        mod.limbs);
+
+    return result;
+}
+
+/*
+    BarrettReducer::mul
+    -------------------
+    Returns the product of two numbers modulo the modulus.
+*/
+
+BigInt BarrettReducer::mul(const BigInt& num1, const BigInt& num2) const {
+    return reduce(num1 * num2);
+}
+
+namespace numericxx::detail {
+
+/*
+    ModularDomain
+    -------------
+    The representation modular exponentiation works in: Montgomery form for
+    odd moduli, and residues reduced with a BarrettReducer for even ones,
+    which Montgomery reduction cannot handle.
+    NOTE: throws a logic_error exception for a zero modulus and an
+    invalid_argument exception for a negative one.
+*/
+
+class ModularDomain {
+    std::optional<MontgomeryContext<BigInt>> montgomery;
+    std::optional<BarrettReducer> barrett;
+    BigInt unit;  // representation of 1
+
+   public:
+    explicit ModularDomain(const BigInt& modulus) {
+        if (modulus == 0) throw std::logic_error("Cannot divide by zero");
+        if (modulus < 0)
+            throw std::invalid_argument("Modulus must be positive");
+
+        if (modulus.test_bit(0)) {
+            montgomery.emplace(modulus);
+            unit = montgomery->one();
+        } else {
+            barrett.emplace(modulus);
+            unit = barrett->reduce(1);
+        }
+    }
+
+    const BigInt& one() const { return unit; }
+
+    BigInt enter(const BigInt& num) const {
+        return montgomery ? montgomery->to_montgomery(num)
+                          : barrett->reduce(num);
+    }
+
+    BigInt leave(const BigInt& num) const {
+        return montgomery ? montgomery->from_montgomery(num) : num;
+    }
+
+    BigInt mul(const BigInt& num1, const BigInt& num2) const {
+        return montgomery ? montgomery->mul(num1, num2)
+                          : barrett->mul(num1, num2);
+    }
+};
+
+/*
+    window_bits
+    -----------
+    Returns the width of the sliding window for an exponent of `exp_bits`
+    bits, the one that minimises the 2^(k-1) products for the table of odd
+    powers plus the about exp_bits / (k + 1) products of the windows.
+*/
+
+size_t window_bits(size_t exp_bits) {
+    size_t k = 1;
+    while (k < 10 and (size_t(1) << k) + exp_bits / (k + 2) <
+                          (size_t(1) << (k - 1)) + exp_bits / (k + 1))
+        k++;
+
+    return k;
+}
+
+/*
+    window_pow
+    ----------
+    Raises `base` to a non-negative exponent by sliding-window
+    exponentiation, multiplying with `mul` in some modular representation in
+    which `one` represents 1. The exponent is read from the top, squaring
+    once per bit and multiplying once per window of up to k bits that starts
+    and ends with a set bit, by an odd power from a precomputed table.
+*/
+
+template <class Multiply>
+BigInt window_pow(const BigInt& base, const BigInt& exp, const BigInt& one,
+                  const Multiply& mul) {
+    size_t bits = exp.bit_length();
+    if (bits == 0) return one;
+
+    // base^1, base^3, ..., base^(2^k - 1)
+    size_t k = window_bits(bits);
+    std::vector<BigInt> odd_powers(size_t(1) << (k - 1));
+    odd_powers[0] = base;
+    if (odd_powers.size() > 1) {
+        BigInt square = mul(base, base);
+        for (size_t i = 1; i < odd_powers.size(); i++)
+            odd_powers[i] = mul(odd_powers[i - 1], square);
+    }
+
+    BigInt result;
+    bool started = false;  // whether result holds anything yet
+    for (size_t i = bits; i-- > 0;) {
+        if (not exp.test_bit(i)) {
+            result = mul(result, result);
+            continue;
+        }
+
+        size_t low = i + 1 > k ? i + 1 - k : 0;
+        while (not exp.test_bit(low)) low++;
+        size_t window = 0;
+        for (size_t j = i + 1; j-- > low;)
+            window = window << 1 | exp.test_bit(j);
+
+        if (started) {
+            for (size_t j = low; j <= i; j++) result = mul(result, result);
+            result = mul(result, odd_powers[window >> 1]);
+        } else {
+            result = odd_powers[window >> 1];
+            started = true;
+        }
+        i = low;
+    }
+
+    return result;
+}
+
+/*
+    check_powmod_arguments
+    ----------------------
+    Rejects the arguments that powmod has no value for.
+*/
+
+void check_powmod_arguments(const BigInt& base, const BigInt& exp) {
+    if (exp < 0) throw std::invalid_argument("Negative exponent in powmod");
+    if (exp == 0 and base == 0)
+        throw std::logic_error("Zero cannot be raised to zero");
+}
+
+}  // namespace numericxx::detail
+
+/*
+    powmod
+    ------
+    Returns base^exp mod modulus, in [0, modulus), by sliding-window
+    exponentiation in Montgomery form for odd moduli and with Barrett
+    reduction for even ones. Intermediate results never exceed twice the size
+    of the modulus.
+    NOTE: throws a logic_error exception for a zero modulus or 0^0, and an
+    invalid_argument exception for a negative modulus or exponent.
+*/
+
+BigInt powmod(const BigInt& base, const BigInt& exp, const BigInt& modulus) {
+    numericxx::detail::check_powmod_arguments(base, exp);
+    numericxx::detail::ModularDomain domain(modulus);
+
+    return domain.leave(numericxx::detail::window_pow(
+        domain.enter(base), exp, domain.one(),
+        [&domain](const BigInt& num1, const BigInt& num2) {
+            return domain.mul(num1, num2);
+        }));
+}
+
+/*
+    powmod (MontgomeryContext)
+    --------------------------
+    Returns base^exp mod the modulus of a Montgomery context, which saves
+    setting one up on every call when exponentiating by the same modulus
+    repeatedly, as in Miller-Rabin tests.
+*/
+
+BigInt powmod(const BigInt& base, const BigInt& exp,
+              const numericxx::MontgomeryContext<BigInt>& context) {
+    numericxx::detail::check_powmod_arguments(base, exp);
+
+    return context.from_montgomery(numericxx::detail::window_pow(
+        context.to_montgomery(base), exp, context.one(),
+        [&context](const BigInt& num1, const BigInt& num2) {
+            return context.mul(num1, num2);
+        }));
+}
+
+/*
+    FixedBasePowmod
+    ---------------
+    Raises a fixed base to many exponents by a fixed modulus with the comb
+    method of Lim and Lee. An exponent of up to `max_bits` bits is read as
+    `teeth` strips of `rows` bits each, and the table holds, for every subset
+    of the strips, the product of base^(2^(t * rows)) over the strips t in it.
+    Each exponentiation then takes only `rows` squarings and at most as many
+    multiplications, one per column of bits across the strips.
+    NOTE: `max_bits` defaults to the size of the modulus and `teeth` to a
+    table size that suits it; longer exponents are still accepted but fall
+    back to sliding-window exponentiation.
+*/
+
+class FixedBasePowmod {
+    numericxx::detail::ModularDomain domain;
+    std::vector<BigInt> table;  // indexed by subsets of strips
+    size_t rows, teeth;
+    bool zero_base;
+
+   public:
+    FixedBasePowmod(const BigInt& base, const BigInt& modulus,
+                    size_t max_bits = 0, size_t teeth = 0);
+
+    BigInt pow(const BigInt& exp) const;
+};
+
+/*
+    FixedBasePowmod::FixedBasePowmod
+    --------------------------------
+    Builds the comb table, at the cost of about max_bits squarings and
+    2^teeth multiplications.
+*/
+
+FixedBasePowmod::FixedBasePowmod(const BigInt& base, const BigInt& modulus,
+                                 size_t max_bits, size_t teeth)
+    : domain(modulus), zero_base(base == 0) {
+    if (max_bits == 0) max_bits = modulus.bit_length();
+    if (teeth == 0) {
+        size_t log_bits = std::bit_width(max_bits);
+        teeth = std::clamp<size_t>(log_bits > 3 ? log_bits - 3 : 1, 1, 8);
+    }
+    this->teeth = teeth;
+    rows = (max_bits + teeth - 1) / teeth;
+
+    auto mul = [this](const BigInt& num1, const BigInt& num2) {
+        return domain.mul(num1, num2);
+    };
+    table.resize(size_t(1) << teeth);
+    table[0] = domain.one();
+    BigInt strip_base = domain.enter(base);  // base^(2^(t * rows))
+    for (size_t t = 0; t < teeth; t++) {
+        size_t first = size_t(1) << t;
+        table[first] = strip_base;
+        for (size_t subset = 1; subset < first; subset++)
+            table[first + subset] = mul(table[subset], strip_base);
+        if (t + 1 < teeth)
+            for (size_t i = 0; i < rows; i++)
+                strip_base = mul(strip_base, strip_base);
+    }
+}
+
+/*
+    FixedBasePowmod::pow
+    --------------------
+    Returns base^exp mod modulus.
+    NOTE: throws an invalid_argument exception for a negative exponent and a
+    logic_error exception for 0^0.
+*/
+
+BigInt FixedBasePowmod::pow(const BigInt& exp) const {
+    if (exp < 0) throw std::invalid_argument("Negative exponent in powmod");
+    if (exp == 0 and zero_base)
+        throw std::logic_error("Zero cannot be raised to zero");
+
+    auto mul = [this](const BigInt& num1, const BigInt& num2) {
+        return domain.mul(num1, num2);
+    };
+    if (exp.bit_length() > rows * teeth)
+        return domain.leave(
+            numericxx::detail::window_pow(table[1], exp, domain.one(), mul));
+
+    BigInt result = domain.one();
+    bool started = false;  // whether result differs from one yet
+    for (size_t row = rows; row-- > 0;) {
+        if (started) result = mul(result, result);
+
+        size_t subset = 0;
+        for (size_t t = 0; t < teeth; t++)
+            subset |= size_t(exp.test_bit(t * rows + row)) << t;
+        if (subset) {
+            result = started ? mul(result, table[subset]) : table[subset];
+            started = true;
+        }
+    }
+
+    return domain.leave(result);
+}
+
+namespace numericxx::detail {
+
+/*
+    exponent_digit
+    --------------
+    Returns the `width` bits of a non-negative exponent from bit `first` up.
+*/
+
+size_t exponent_digit(const BigInt& exp, size_t first, size_t width) {
+    size_t digit = 0;
+    for (size_t j = first + width; j-- > first;)
+        digit = digit << 1 | exp.test_bit(j);
+
+    return digit;
+}
+
+/*
+    straus_pow
+    ----------
+    Straus's method, a generalisation of Shamir's trick: every base gets a
+    table of its powers up to 2^w - 1, and the exponents are read together w
+    bits at a time from the top, so that the squarings are shared by all of
+    the bases and each window costs one multiplication per base.
+*/
+
+BigInt straus_pow(const ModularDomain& domain, const std::vector<BigInt>& bases,
+                  const std::vector<BigInt>& exps, size_t bits, size_t w) {
+    std::vector<std::vector<BigInt>> powers(bases.size());
+    for (size_t i = 0; i < bases.size(); i++) {
+        powers[i].resize(size_t(1) << w);
+        powers[i][1] = bases[i];
+        for (size_t d = 2; d < powers[i].size(); d++)
+            powers[i][d] = domain.mul(powers[i][d - 1], bases[i]);
+    }
+
+    BigInt result = domain.one();
+    bool started = false;  // whether result differs from one yet
+    for (size_t window = (bits + w - 1) / w; window-- > 0;) {
+        if (started)
+            for (size_t j = 0; j < w; j++) result = domain.mul(result, result);
+
+        for (size_t i = 0; i < bases.size(); i++) {
+            size_t digit = exponent_digit(exps[i], window * w, w);
+            if (digit == 0) continue;
+            result = started ? domain.mul(result, powers[i][digit])
+                             : powers[i][digit];
+            started = true;
+        }
+    }
+
+    return result;
+}
+
+/*
+    pippenger_pow
+    -------------
+    Pippenger's bucket method: for each window of c bits of the exponents,
+    every base is multiplied into the bucket of its digit, and the buckets are
+    combined into the product of bucket_d^d over the digits d by two running
+    products, so that a window costs one multiplication per base plus at most
+    2^(c+1) however many bases share it.
+*/
+
+BigInt pippenger_pow(const ModularDomain& domain,
+                     const std::vector<BigInt>& bases,
+                     const std::vector<BigInt>& exps, size_t bits, size_t c) {
+    std::vector<BigInt> buckets(size_t(1) << c);
+    std::vector<bool> filled(buckets.size());
+
+    BigInt result = domain.one();
+    bool started = false;  // whether result differs from one yet
+    for (size_t window = (bits + c - 1) / c; window-- > 0;) {
+        if (started)
+            for (size_t j = 0; j < c; j++) result = domain.mul(result, result);
+
+        std::fill(filled.begin(), filled.end(), false);
+        for (size_t i = 0; i < bases.size(); i++) {
+            size_t digit = exponent_digit(exps[i], window * c, c);
+            if (digit == 0) continue;
+            buckets[digit] = filled[digit]
+                                 ? domain.mul(buckets[digit], bases[i])
+                                 : bases[i];
+            filled[digit] = true;
+        }
+
+        // the running product over digits from d up is used d times
+        BigInt running, sum;
+        bool has_running = false, has_sum = false;
+        for (size_t digit = buckets.size(); digit-- > 1;) {
+            if (filled[digit]) {
+                running = has_running ? domain.mul(running, buckets[digit])
+                                      : buckets[digit];
+                has_running = true;
+            }
+            if (has_running) {
+                sum = has_sum ? domain.mul(sum, running) : running;
+                has_sum = true;
+            }
+        }
+
+        if (has_sum) {
+            result = started ? domain.mul(result, sum) : sum;
+            started = true;
+        }
+    }
+
+    return result;
+}
+
+}  // namespace numericxx::detail
+
+/*
+    multi_powmod
+    ------------
+    Returns the product of bases[i]^exps[i] mod modulus, in [0, modulus),
+    sharing the squarings between all of the bases instead of exponentiating
+    each one separately. Straus's method is used for a few bases and
+    Pippenger's for many, whichever the estimated number of multiplications
+    favours, with window widths chosen the same way.
+    NOTE: throws an invalid_argument exception if the vectors differ in size
+    and otherwise follows powmod, including for 0^0.
+*/
+
+BigInt multi_powmod(const std::vector<BigInt>& bases,
+                    const std::vector<BigInt>& exps, const BigInt& modulus) {
+    if (bases.size() != exps.size())
+        throw std::invalid_argument("multi_powmod needs one exponent per base");
+    for (size_t i = 0; i < bases.size(); i++)
+        numericxx::detail::check_powmod_arguments(bases[i], exps[i]);
+    numericxx::detail::ModularDomain domain(modulus);
+
+    // bases with a zero exponent contribute nothing
+    std::vector<BigInt> domain_bases, nonzero_exps;
+    size_t bits = 0;
+    for (size_t i = 0; i < bases.size(); i++) {
+        if (exps[i] == 0) continue;
+        domain_bases.push_back(domain.enter(bases[i]));
+        nonzero_exps.push_back(exps[i]);
+        bits = std::max(bits, exps[i].bit_length());
+    }
+    size_t k = domain_bases.size();
+    if (k == 0) return domain.leave(domain.one());
+
+    // multiplications other than the bits squarings that both share
+    size_t straus_w = 1, straus_cost = SIZE_MAX;
+    for (size_t w = 1; w <= 8; w++) {
+        size_t cost = k * ((size_t(1) << w) - 2 + (bits + w - 1) / w);
+        if (cost < straus_cost) {
+            straus_cost = cost;
+            straus_w = w;
+        }
+    }
+    size_t pippenger_c = 1, pippenger_cost = SIZE_MAX;
+    for (size_t c = 1; c <= 16; c++) {
+        size_t cost = (bits + c - 1) / c * (k + (size_t(2) << c));
+        if (cost < pippenger_cost) {
+            pippenger_cost = cost;
+            pippenger_c = c;
+        }
+    }
+
+    return domain.leave(
+        straus_cost <= pippenger_cost
+            ? numericxx::detail::straus_pow(domain, domain_bases, nonzero_exps,
+                                            bits, straus_w)
+            : numericxx::detail::pippenger_pow(
+                  domain, domain_bases, nonzero_exps, bits, pippenger_c));
+}
 
-#endif // BIGINT_TYPE_SPECIALIZATIONS_HPP
\ No newline at end of file
+#endif  // BIG_INT_MODULAR_ARITHMETIC_HPP
@@ -0,0 +1,96 @@
+/*
+    Addition and subtraction: carries and borrows across limbs, the in-place
+    operators and operands that alias the result.
+*/
+
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+void test_carries_and_borrows() {
+    BigInt max192("6277101735386680763835789423207666416102355444464034512895");
+    CHECK_EQ((max192 + 1).to_string(),
+             "6277101735386680763835789423207666416102355444464034512896");
+    CHECK_EQ((max192 + 1 - 1).to_string(), max192.to_string());
+    CHECK_EQ((1 - max192).to_string(),
+             "-6277101735386680763835789423207666416102355444464034512894");
+    CHECK_EQ((max192 + 1 - BigInt("18446744073709551616")).to_string(),
+             "6277101735386680763835789423207666416083908700390324961280");
+
+    // operands of different signs and lengths
+    CHECK_EQ((BigInt("-18446744073709551616") + 1).to_string(),
+             "-18446744073709551615");
+    CHECK_EQ((BigInt(-1) + BigInt("18446744073709551616")).to_string(),
+             "18446744073709551615");
+    CHECK_EQ((BigInt("-18446744073709551616") - BigInt("-18446744073709551616"))
+                 .to_string(),
+             "0");
+    CHECK_EQ((BigInt(-5) - 7).to_string(), "-12");
+    CHECK_EQ((BigInt(-5) + std::string("-7")).to_string(), "-12");
+    CHECK_EQ((3 - BigInt(10)).to_string(), "-7");
+}
+
+void test_in_place() {
+    BigInt num("18446744073709551615");
+    num += 1;
+    CHECK_EQ(num.to_string(), "18446744073709551616");
+    num -= 1;
+    CHECK_EQ(num.to_string(), "18446744073709551615");
+    num -= BigInt("36893488147419103230");
+    CHECK_EQ(num.to_string(), "-18446744073709551615");
+    num += BigInt("18446744073709551615");
+    CHECK_EQ(num.to_string(), "0");
+    num -= "340282366920938463463374607431768211456";
+    CHECK_EQ(num.to_string(), "-340282366920938463463374607431768211456");
+    num += -5;
+    CHECK_EQ(num.to_string(), "-340282366920938463463374607431768211461");
+
+    // the result aliases both operands
+    BigInt twice("170141183460469231731687303715884105728");  // 2^127
+    twice += twice;
+    CHECK_EQ(twice.to_string(), "340282366920938463463374607431768211456");
+    twice -= twice;
+    CHECK_EQ(twice.to_string(), "0");
+
+    // adding small terms into a long accumulator, and taking them back out
+    BigInt accumulator = pow(BigInt(10), 500) - 1;
+    BigInt copy = accumulator;
+    for (int i = 0; i < 1000; i++) accumulator += i;
+    CHECK_EQ((accumulator - copy).to_string(), "499500");
+    for (int i = 0; i < 1000; i++) accumulator -= i;
+    CHECK(accumulator == copy);
+    accumulator += 1;
+    CHECK_EQ(accumulator.to_string(), "1" + std::string(500, '0'));
+}
+
+void test_identities() {
+    DigitSource source(3);
+    for (size_t length1 : {1, 19, 20, 39, 400})
+        for (size_t length2 : {1, 20, 38, 400}) {
+            BigInt num1(source.nines(length1));
+            BigInt num2 = -BigInt(source.digits(length2));
+            BigInt sum = num1 + num2;
+            CHECK(sum - num2 == num1);
+            CHECK(sum - num1 == num2);
+            CHECK(num2 + num1 == sum);
+            CHECK(num1 - num2 == -(num2 - num1));
+
+            BigInt accumulator = num1;
+            accumulator += num2;
+            CHECK(accumulator == sum);
+            accumulator -= num1;
+            CHECK(accumulator == num2);
+        }
+}
+
+int main() {
+    test_carries_and_borrows();
+    test_in_place();
+    test_identities();
+
+    return numericxx::test::finish();
+}
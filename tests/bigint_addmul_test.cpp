@@ -0,0 +1,100 @@
+/*
+    addmul, submul and mul_word_add against forming the product and adding
+    it: every sign combination, results that cross zero or fill the spare top
+    limb, aliased operands and factors on either side of the Karatsuba
+    threshold.
+*/
+
+#include <climits>
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+void test_carries() {
+    // a sum that fills the spare top limb is not a wrapped subtraction
+    BigInt acc = pow(BigInt(2), 128) - 1;
+    addmul(acc, BigInt(1), BigInt(1));
+    CHECK(acc == pow(BigInt(2), 128));
+    acc = pow(BigInt(2), 127);
+    addmul(acc, pow(BigInt(2), 63), BigInt(2) * pow(BigInt(2), 63));
+    CHECK(acc == pow(BigInt(2), 128));
+
+    // subtractions that stay positive, reach zero and go below zero
+    acc = pow(BigInt(2), 192);
+    submul(acc, pow(BigInt(2), 64), pow(BigInt(2), 64));
+    CHECK(acc == pow(BigInt(2), 192) - pow(BigInt(2), 128));
+    submul(acc, acc, BigInt(1));
+    CHECK_EQ(acc.to_string(), "0");
+    submul(acc, BigInt(3), BigInt(5));
+    CHECK_EQ(acc.to_string(), "-15");
+    addmul(acc, BigInt(-3), BigInt(-5));
+    CHECK_EQ(acc.to_string(), "0");
+}
+
+void test_integers() {
+    BigInt acc = 10;
+    addmul(acc, BigInt("18446744073709551616"), LLONG_MIN);
+    CHECK_EQ(acc.to_string(), "-170141183460469231731687303715884105718");
+    submul(acc, BigInt("18446744073709551616"), LLONG_MIN);
+    CHECK_EQ(acc.to_string(), "10");
+    submul(acc, BigInt(-2), -5);
+    CHECK_EQ(acc.to_string(), "0");
+    addmul(acc, BigInt(0), LLONG_MAX);
+    CHECK_EQ(acc.to_string(), "0");
+
+    // Horner's rule, one digit at a time
+    BigInt num;
+    std::string digits = "98765432109876543210987654321098765432109876543210";
+    for (char digit : digits) mul_word_add(num, 10, digit - '0');
+    CHECK_EQ(num.to_string(), digits);
+    mul_word_add(num, -1, 0);
+    CHECK(num == -BigInt(digits));
+    mul_word_add(num, 1, LLONG_MIN);
+    CHECK(num == -BigInt(digits) + LLONG_MIN);
+    mul_word_add(num, 0, -7);
+    CHECK_EQ(num.to_string(), "-7");
+}
+
+void test_against_products() {
+    DigitSource source(21);
+    for (size_t length1 : {5, 40, 700, 3000})
+        for (size_t length2 : {1, 19, 300, 1500})
+            for (size_t acc_length : {1, 50, 2000}) {
+                BigInt x(source.digits(length1)), y(source.digits(length2));
+                BigInt start(source.nines(acc_length));
+                for (const BigInt& p : {x, -x})
+                    for (const BigInt& s : {start, -start}) {
+                        BigInt acc = s;
+                        addmul(acc, p, y);
+                        CHECK(acc == s + p * y);
+                        submul(acc, p, y);
+                        CHECK(acc == s);
+                        submul(acc, y, p);
+                        CHECK(acc == s - p * y);
+                    }
+            }
+
+    // the accumulator is also a factor
+    BigInt num(source.digits(500));
+    BigInt acc = num;
+    addmul(acc, acc, acc);
+    CHECK(acc == num + num * num);
+    acc = num;
+    submul(acc, acc, num);
+    CHECK(acc == num - num * num);
+    acc = num;
+    addmul(acc, acc, 3);
+    CHECK(acc == num * 4);
+}
+
+int main() {
+    test_carries();
+    test_integers();
+    test_against_products();
+
+    return numericxx::test::finish();
+}
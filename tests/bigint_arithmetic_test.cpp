@@ -0,0 +1,180 @@
+/*
+    Construction, conversion and the basic arithmetic of BigInt, checked
+    against known values and against the reference product.
+*/
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+using numericxx::test::multiply_decimal;
+
+const std::string FACTORIAL_100 =
+    "933262154439441526816992388562667004907159682643816214685929638952175999"
+    "932299156089414639761565182862536979208272237582511852109168640000000000"
+    "00000000000000";
+
+void test_construction() {
+    CHECK_EQ(BigInt().to_string(), "0");
+    CHECK_EQ(BigInt(0).to_string(), "0");
+    CHECK_EQ(BigInt(-42).to_string(), "-42");
+    CHECK_EQ(BigInt(9223372036854775807ll).to_string(), "9223372036854775807");
+    CHECK_EQ(BigInt(-9223372036854775807ll - 1).to_string(),
+             "-9223372036854775808");
+    CHECK_EQ(BigInt("+123").to_string(), "123");
+    CHECK_EQ(BigInt("-0").to_string(), "0");
+    CHECK_EQ(BigInt("000123").to_string(), "123");
+    CHECK_EQ(BigInt(FACTORIAL_100).to_string(), FACTORIAL_100);
+    CHECK_THROWS(BigInt("12a3"), std::invalid_argument);
+    CHECK_THROWS(BigInt("--1"), std::invalid_argument);
+
+    BigInt num;
+    num = "-18446744073709551616";
+    CHECK_EQ(num.to_string(), "-18446744073709551616");
+    num = 7;
+    CHECK_EQ(num.to_string(), "7");
+}
+
+void test_conversion() {
+    CHECK_EQ(BigInt("2147483647").to_int(), 2147483647);
+    CHECK_EQ(BigInt("-9223372036854775808").to_long_long(),
+             -9223372036854775807ll - 1);
+    CHECK_THROWS(BigInt("2147483648").to_int(), std::out_of_range);
+    CHECK_THROWS(BigInt("9223372036854775808").to_long_long(),
+                 std::out_of_range);
+    CHECK_THROWS(BigInt("-9223372036854775809").to_long_long(),
+                 std::out_of_range);
+
+    std::ostringstream out;
+    out << BigInt("-340282366920938463463374607431768211456");
+    CHECK_EQ(out.str(), "-340282366920938463463374607431768211456");
+
+    std::istringstream in("12345678901234567890123 -5");
+    BigInt num1, num2;
+    in >> num1 >> num2;
+    CHECK_EQ(num1.to_string(), "12345678901234567890123");
+    CHECK_EQ(num2.to_string(), "-5");
+}
+
+void test_addition_and_subtraction() {
+    BigInt max64("18446744073709551615");
+    CHECK_EQ((max64 + 1).to_string(), "18446744073709551616");
+    CHECK_EQ((BigInt("18446744073709551616") - 1).to_string(),
+             "18446744073709551615");
+    CHECK_EQ((BigInt("340282366920938463463374607431768211455") + 1)
+                 .to_string(),
+             "340282366920938463463374607431768211456");
+    CHECK_EQ((BigInt(5) - BigInt("18446744073709551621")).to_string(),
+             "-18446744073709551616");
+    BigInt big("1000000000000000000000");
+    CHECK_EQ((-big + big).to_string(), "0");
+    CHECK_EQ((BigInt(-7) - BigInt(-7)).to_string(), "0");
+
+    BigInt num("99999999999999999999999999999999999999");
+    num += 1;
+    CHECK_EQ(num.to_string(), "100000000000000000000000000000000000000");
+    num -= BigInt("100000000000000000000000000000000000001");
+    CHECK_EQ(num.to_string(), "-1");
+    CHECK_EQ((++num).to_string(), "0");
+    CHECK_EQ((num--).to_string(), "0");
+    CHECK_EQ(num.to_string(), "-1");
+}
+
+void test_multiplication() {
+    BigInt factorial = 1;
+    for (int i = 2; i <= 100; i++) factorial *= i;
+    CHECK_EQ(factorial.to_string(), FACTORIAL_100);
+
+    BigInt max128("340282366920938463463374607431768211455");
+    CHECK_EQ((max128 * max128).to_string(),
+             "115792089237316195423570985008687907852589419931798687112530834"
+             "793049593217025");
+    CHECK_EQ((BigInt(-3) * BigInt("12345678901234567890")).to_string(),
+             "-37037036703703703670");
+    CHECK_EQ((BigInt(0) * BigInt("-12345678901234567890")).to_string(), "0");
+    CHECK_EQ(pow(BigInt(2), 200).to_string(),
+             "1606938044258990275541962092341162602522202993782792835301376");
+
+    // balanced and unbalanced operands on either side of the Karatsuba
+    // threshold, against the reference product
+    DigitSource source(1);
+    for (size_t length1 : {1, 19, 20, 100, 700, 1500})
+        for (size_t length2 : {1, 20, 400, 1500}) {
+            std::string num1 = source.digits(length1);
+            std::string num2 = source.nines(length2);
+            std::string product = multiply_decimal(num1, num2);
+            CHECK_EQ((BigInt(num1) * BigInt(num2)).to_string(), product);
+            CHECK(-BigInt(num1) * BigInt(num2) == -BigInt(product));
+        }
+}
+
+void test_division() {
+    BigInt factorial(FACTORIAL_100);
+    BigInt divisor("18446744073709551629");  // 2^64 + 13
+    CHECK_EQ((factorial / divisor).to_string(),
+             "505922427670872429600298801595055349555132167893233918983983009"
+             "597675401649436563148037956589793260930944921827774541491192261"
+             "8362811197148");
+    CHECK_EQ((factorial % divisor).to_string(), "10818498240196445908");
+
+    BigInt num1("12345678901234567890123456789012345678901234567890");
+    BigInt num2("98765432109876543210987654321");
+    CHECK_EQ((num1 / num2).to_string(), "124999998860937500014");
+    CHECK_EQ((num1 % num2).to_string(), "23533950614699073961469907396");
+
+    // the quotient is truncated and the remainder takes the dividend's sign
+    CHECK_EQ((BigInt(-7) / 2).to_string(), "-3");
+    CHECK_EQ((BigInt(-7) % 2).to_string(), "-1");
+    CHECK_EQ((BigInt(7) / -2).to_string(), "-3");
+    CHECK_EQ((BigInt(7) % -2).to_string(), "1");
+    CHECK_EQ((BigInt(3) / BigInt("100000000000000000000")).to_string(), "0");
+    CHECK_THROWS(BigInt(1) / BigInt(0), std::logic_error);
+    CHECK_THROWS(BigInt(1) % 0, std::logic_error);
+
+    // q * b + r == a with |r| < |b|, for dividends up to 1500 digits
+    DigitSource source(2);
+    for (size_t length1 : {20, 40, 300, 1500})
+        for (size_t length2 : {1, 19, 21, 150, 700}) {
+            if (length2 > length1) continue;
+            BigInt dividend(source.digits(length1));
+            BigInt divisor(source.nines(length2));
+            BigInt quotient = dividend / divisor;
+            BigInt remainder = dividend % divisor;
+            CHECK(quotient * divisor + remainder == dividend);
+            CHECK(remainder >= 0 and remainder < divisor);
+        }
+}
+
+void test_comparison_and_functions() {
+    CHECK(BigInt("-18446744073709551616") < BigInt(-1));
+    CHECK(BigInt("18446744073709551616") > BigInt("18446744073709551615"));
+    CHECK(BigInt(5) == 5);
+    CHECK(BigInt("123") != "124");
+    CHECK(-1 < BigInt(0));
+
+    CHECK_EQ(abs(BigInt("-99")).to_string(), "99");
+    CHECK_EQ(pow(BigInt(-3), 3).to_string(), "-27");
+    CHECK_EQ(pow(BigInt(10), 0).to_string(), "1");
+    CHECK_EQ(big_pow10(25).to_string(), "10000000000000000000000000");
+    CHECK_EQ(sqrt(BigInt("20000000000000000000000000000000000000000"))
+                 .to_string(),
+             "141421356237309504880");
+    CHECK_EQ(sqrt(BigInt(0)).to_string(), "0");
+    CHECK_THROWS(sqrt(BigInt(-4)), std::invalid_argument);
+}
+
+int main() {
+    test_construction();
+    test_conversion();
+    test_addition_and_subtraction();
+    test_multiplication();
+    test_division();
+    test_comparison_and_functions();
+
+    return numericxx::test::finish();
+}
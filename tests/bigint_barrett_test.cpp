@@ -0,0 +1,82 @@
+/*
+    BarrettReducer against the floored BigInt remainder, for moduli of every
+    normalisation on both sides of the Karatsuba threshold and inputs from a
+    single step to many, including negative inputs and exact multiples.
+*/
+
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::SplitMix64;
+using numericxx::test::DigitSource;
+
+// The residue of num modulo a positive modulus, in [0, modulus)
+BigInt floor_mod(const BigInt& num, const BigInt& modulus) {
+    return std::get<1>(divmod_floor(num, modulus));
+}
+
+void test_moduli() {
+    SplitMix64 engine(28);
+    DigitSource source(29);
+    BigInt limb = pow(BigInt(2), 64);
+    std::vector<BigInt> moduli = {1, 2, 3, 1000000007, limb - 1, limb,
+                                  limb + 1, pow(limb, 2) - 1};
+    for (int limbs : {5, 31, 32, 33, 100}) {
+        moduli.push_back(pow(limb, limbs) - 1);          // no normalising
+        moduli.push_back(pow(limb, limbs - 1) * 3 + 7);  // shifted by 62
+        moduli.push_back(random_bits(64 * limbs - 17, engine) + 1);
+    }
+    moduli.push_back(BigInt(source.digits(4000)));
+
+    for (const BigInt& modulus : moduli) {
+        BarrettReducer reducer(modulus);
+        CHECK(reducer.modulus() == modulus);
+        size_t bits = modulus.bit_length();
+        for (size_t input_bits : {bits / 2, bits, 2 * bits, 2 * bits + 64,
+                                  7 * bits + 100}) {
+            BigInt num = random_bits(input_bits, engine);
+            CHECK(reducer.reduce(num) == floor_mod(num, modulus));
+            CHECK(reducer.reduce(-num) == floor_mod(-num, modulus));
+        }
+
+        // residues at the edges of the range
+        CHECK(reducer.reduce(0) == 0);
+        CHECK(reducer.reduce(modulus) == 0);
+        CHECK(reducer.reduce(modulus * modulus) == 0);
+        CHECK(reducer.reduce(modulus * modulus - 1) == modulus - 1);
+        CHECK(reducer.reduce(-modulus * 12345) == 0);
+        CHECK(reducer.reduce(BigInt(-1)) == modulus - 1);
+
+        BigInt a = random_below(modulus, engine);
+        BigInt b = random_below(modulus, engine);
+        CHECK(reducer.mul(a, b) == a * b % modulus);
+        CHECK(reducer.mul(modulus - 1, modulus - 1) == floor_mod(1, modulus));
+        CHECK(reducer.mul(-a, b) == floor_mod(-a * b, modulus));
+    }
+}
+
+void test_batches() {
+    BarrettReducer reducer(BigInt("340282366920938463463374607431768211297"));
+    std::vector<BigInt> nums = {-5, 0, pow(BigInt(10), 100),
+                                pow(BigInt(3), 500)};
+    std::vector<BigInt> residues(nums.size());
+    CHECK(reducer.reduce(nums.begin(), nums.end(), residues.begin()) ==
+          residues.end());
+    for (size_t i = 0; i < nums.size(); i++)
+        CHECK(residues[i] == floor_mod(nums[i], reducer.modulus()));
+
+    CHECK_THROWS(BarrettReducer(BigInt(0)), std::invalid_argument);
+    CHECK_THROWS(BarrettReducer(BigInt(-3)), std::invalid_argument);
+}
+
+int main() {
+    test_moduli();
+    test_batches();
+
+    return numericxx::test::finish();
+}
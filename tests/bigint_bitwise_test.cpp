@@ -0,0 +1,122 @@
+/*
+    Bitwise operators, shifts and bit queries on the infinitely sign-extended
+    two's complement, against values computed independently and against the
+    arithmetic identities they satisfy.
+*/
+
+#include <string>
+#include <tuple>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+// three limbs, two limbs with both ends set, and a single bit above 2^128
+const BigInt a("446371678960830626602075884953218503818668484034445643535");
+const BigInt b("-340282366920938463444927863358058659841");
+const BigInt c("-1361129467683753853853498429727072845824");
+
+void test_known_values() {
+    CHECK_EQ((a & b).to_string(),
+             "446371678960830626263305884107484211302708217501577056015");
+    CHECK_EQ((a | b).to_string(), "-1512366075204170928967596825190072321");
+    CHECK_EQ((a ^ b).to_string(),
+             "-446371678960830626264818250182688382231675814326767128336");
+    CHECK_EQ((a & c).to_string(),
+             "446371678960830626263305884107484211301623114909005905920");
+    CHECK_EQ((a | c).to_string(), "-1022359466838019561336453060601633108209");
+    CHECK_EQ((a ^ c).to_string(),
+             "-446371678960830627285665350945503772638076175510639014129");
+    CHECK_EQ((b & c).to_string(), "-1361129467683753853853498429727072845824");
+    CHECK_EQ((b | c).to_string(), "-340282366920938463444927863358058659841");
+    CHECK_EQ((b ^ c).to_string(), "1020847100762815390408570566369014185983");
+
+    CHECK_EQ((~a).to_string(),
+             "-446371678960830626602075884953218503818668484034445643536");
+    CHECK_EQ((~b).to_string(), "340282366920938463444927863358058659840");
+    CHECK(~BigInt(0) == -1 and ~BigInt(-1) == 0);
+
+    CHECK_EQ((a >> 67).to_string(), "3024732150408341860230788468441777730");
+    CHECK_EQ((-a >> 67).to_string(), "-3024732150408341860230788468441777731");
+    CHECK_EQ((b >> 67).to_string(), "-2305843009213693952");
+    CHECK_EQ((c >> 67).to_string(), "-9223372036854775808");
+    CHECK_EQ((b >> 1).to_string(), "-170141183460469231722463931679029329921");
+    CHECK(a >> 200 == 0 and b >> 200 == -1 and c >> 200 == -1);
+    CHECK_EQ((b << 67).to_string(),
+             "-50216813883093446107964056450293823621259420648847806824448");
+
+    CHECK(a.bit_length() == 189 and a.trailing_zeros() == 0);
+    CHECK(a.popcount() == 96 and (-a).popcount() == 96);
+    CHECK(b.bit_length() == 128 and b.popcount() == 65);
+    CHECK(c.bit_length() == 131 and c.trailing_zeros() == 130);
+    CHECK(c.popcount() == 1);
+    CHECK(BigInt(0).bit_length() == 0 and BigInt(0).trailing_zeros() == 0);
+
+    bool b_bits[] = {1, 1, 1, 0, 0, 0, 1, 1};
+    size_t b_indices[] = {0, 1, 63, 64, 65, 127, 128, 500};
+    for (size_t i = 0; i < 8; i++) CHECK(b.test_bit(b_indices[i]) == b_bits[i]);
+    CHECK(not c.test_bit(0) and not c.test_bit(129));
+    CHECK(c.test_bit(130) and c.test_bit(131) and c.test_bit(500));
+    CHECK(a.test_bit(188) and not a.test_bit(189));
+}
+
+void test_compound_assignment() {
+    BigInt num = a;
+    num &= b;
+    num |= c;
+    num ^= a;
+    CHECK(num == (((a & b) | c) ^ a));
+
+    num = b;
+    num <<= 130;
+    num >>= 3;
+    CHECK(num == b << 127);
+    num >>= 1000;
+    CHECK(num == -1);
+}
+
+void test_identities() {
+    DigitSource source(20);
+    for (size_t length1 : {1, 19, 20, 60, 400})
+        for (size_t length2 : {1, 20, 100}) {
+            BigInt x(source.digits(length1)), y(source.nines(length2));
+            for (const BigInt& p : {x, -x})
+                for (const BigInt& q : {y, -y}) {
+                    CHECK((p & q) + (p | q) == p + q);
+                    CHECK((p ^ q) == (p | q) - (p & q));
+                    CHECK((p & ~q) == (p ^ (p & q)));
+                    CHECK(~(p | q) == (~p & ~q));
+                }
+
+            for (size_t shift : {1, 63, 64, 65, 200}) {
+                BigInt power = pow(BigInt(2), shift);
+                for (const BigInt& p : {x, -x}) {
+                    CHECK((p << shift) == p * power);
+                    CHECK((p >> shift) == std::get<0>(divmod_floor(p, power)));
+                    CHECK(((p << shift) >> shift) == p);
+                }
+            }
+        }
+}
+
+void test_sqrt() {
+    CHECK_EQ(sqrt(pow(BigInt(10), 101)).to_string(),
+             "316227766016837933199889354443271853371955513932521");
+    CHECK_EQ(sqrt(pow(BigInt(2), 200) - 1).to_string(),
+             "1267650600228229401496703205375");
+    for (int root : {1, 2, 3, 1000000007}) {
+        BigInt square = BigInt(root) * root;
+        CHECK(sqrt(square) == root and sqrt(square - 1) == root - 1);
+    }
+}
+
+int main() {
+    test_known_values();
+    test_compound_assignment();
+    test_identities();
+    test_sqrt();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,129 @@
+/*
+    to_chars and from_chars in every base from 2 to 36: known values, buffers
+    that are exactly or almost large enough, partial parses and round trips.
+*/
+
+#include <charconv>
+#include <climits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+// Formats a BigInt in a base through a buffer of to_chars_size characters
+std::string format(const BigInt& num, int base) {
+    std::string chars(to_chars_size(num, base), '\0');
+    std::to_chars_result result =
+        to_chars(chars.data(), chars.data() + chars.size(), num, base);
+    CHECK(result.ec == std::errc());
+    chars.resize(result.ptr - chars.data());
+    return chars;
+}
+
+// Parses a whole string as a BigInt in a base
+BigInt parse(const std::string& chars, int base) {
+    BigInt num;
+    std::from_chars_result result =
+        from_chars(chars.data(), chars.data() + chars.size(), num, base);
+    CHECK(result.ec == std::errc());
+    CHECK(result.ptr == chars.data() + chars.size());
+    return num;
+}
+
+void test_known_values() {
+    BigInt power = pow(BigInt(2), 128);
+    CHECK_EQ(format(power, 2), "1" + std::string(128, '0'));
+    CHECK_EQ(format(power, 16), "1" + std::string(32, '0'));
+    CHECK_EQ(format(power - 1, 16), std::string(32, 'f'));
+    CHECK_EQ(format(power, 10), "340282366920938463463374607431768211456");
+    CHECK_EQ(format(power, 36), "f5lxx1zz5pnorynqglhzmsp34");
+    CHECK_EQ(format(-power, 8), "-4" + std::string(42, '0'));
+    CHECK_EQ(format(BigInt(0), 7), "0");
+    CHECK_EQ(format(BigInt(35), 36), "z");
+    CHECK_EQ(format(BigInt(LLONG_MIN), 10), std::to_string(LLONG_MIN));
+
+    CHECK(parse("FfFfFfFfFfFfFfFf", 16) == pow(BigInt(2), 64) - 1);
+    CHECK(parse("-f5lxx1zz5pnorynqglhzmsp34", 36) == -power);
+    CHECK(parse("F5LXX1ZZ5PNORYNQGLHZMSP34", 36) == power);
+    CHECK(parse("0000000000000000000000000000001", 2) == 1);
+    CHECK_EQ(parse("-0", 10).to_string(), "0");
+}
+
+void test_buffers() {
+    // a buffer one character short fails, and leaves the end at `last`
+    BigInt num("-123456789012345678901234567890");
+    std::string expected = num.to_string();
+    char chars[64];
+    std::to_chars_result result =
+        to_chars(chars, chars + expected.size() - 1, num);
+    CHECK(result.ec == std::errc::value_too_large);
+    CHECK(result.ptr == chars + expected.size() - 1);
+
+    // exactly enough, though less than the bound, is formatted aside
+    CHECK(to_chars_size(num) >= expected.size());
+    result = to_chars(chars, chars + expected.size(), num);
+    CHECK(result.ec == std::errc());
+    CHECK_EQ(std::string(chars, result.ptr), expected);
+
+    result = to_chars(chars, chars, BigInt(0));
+    CHECK(result.ec == std::errc::value_too_large);
+
+    std::ostringstream out;
+    out << num << ' ' << pow(BigInt(10), 200);
+    CHECK_EQ(out.str(), expected + " 1" + std::string(200, '0'));
+}
+
+void test_partial_parses() {
+    BigInt num = 42;
+    std::string chars = "123xyz";
+    std::from_chars_result result =
+        from_chars(chars.data(), chars.data() + chars.size(), num);
+    CHECK(result.ec == std::errc() and result.ptr == chars.data() + 3);
+    CHECK(num == 123);
+
+    // digits beyond the base end the number
+    chars = "-12345";
+    result = from_chars(chars.data(), chars.data() + chars.size(), num, 4);
+    CHECK(result.ptr == chars.data() + 4 and num == -27);
+
+    // no digits at all leaves the number unchanged
+    for (std::string bad : {"", "-", "+5", " 5", "-x"}) {
+        result = from_chars(bad.data(), bad.data() + bad.size(), num);
+        CHECK(result.ec == std::errc::invalid_argument);
+        CHECK(result.ptr == bad.data());
+        CHECK(num == -27);
+    }
+
+    CHECK_THROWS(to_chars_size(num, 1), std::invalid_argument);
+    CHECK_THROWS(to_chars(chars.data(), chars.data(), num, 37),
+                 std::invalid_argument);
+    CHECK_THROWS(from_chars(chars.data(), chars.data(), num, 0),
+                 std::invalid_argument);
+}
+
+void test_round_trips() {
+    DigitSource source(17);
+    for (int base = 2; base <= 36; base++)
+        for (size_t length : {1, 19, 20, 40, 300, 3000}) {
+            BigInt num(source.digits(length));
+            for (const BigInt& value : {num, -num}) {
+                std::string chars = format(value, base);
+                CHECK(chars.size() <= to_chars_size(value, base));
+                CHECK(parse(chars, base) == value);
+            }
+        }
+}
+
+int main() {
+    test_known_values();
+    test_buffers();
+    test_partial_parses();
+    test_round_trips();
+
+    return numericxx::test::finish();
+}
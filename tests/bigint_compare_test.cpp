@@ -0,0 +1,92 @@
+/*
+    compare and the relational operators against BigInts, long longs and
+    decimal strings, around the point where the digit count stops deciding
+    the order and around the limb boundaries.
+*/
+
+#include <climits>
+#include <compare>
+#include <stdexcept>
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+// The sign of a compare result
+int sign_of(int result) { return (result > 0) - (result < 0); }
+
+void test_integers() {
+    BigInt limb("18446744073709551616");  // 2^64
+    CHECK(sign_of(limb.compare(LLONG_MAX)) == 1);
+    CHECK(sign_of((-limb).compare(LLONG_MIN)) == -1);
+    CHECK(sign_of(BigInt(LLONG_MIN).compare(LLONG_MIN)) == 0);
+    CHECK(sign_of(BigInt(LLONG_MIN).compare(LLONG_MIN + 1LL)) == -1);
+    CHECK(sign_of(BigInt(0).compare(-1)) == 1);
+    CHECK(sign_of(BigInt(-5).compare(-4)) == -1);
+
+    CHECK((BigInt(3) <=> 5) == std::strong_ordering::less);
+    CHECK((BigInt(-3) <=> -5) == std::strong_ordering::greater);
+    CHECK((limb <=> limb) == std::strong_ordering::equal);
+    CHECK((-limb <=> BigInt(-1)) == std::strong_ordering::less);
+    CHECK(5 < BigInt(6) and 6 <= BigInt(6) and 7 > BigInt(6));
+    CHECK(-7 < BigInt(-6) and 6 != BigInt(-6) and 6 == BigInt(6));
+}
+
+void test_strings() {
+    BigInt limb("18446744073709551616");  // 2^64
+    CHECK(limb.compare("18446744073709551616") == 0);
+    CHECK(sign_of(limb.compare("18446744073709551615")) == 1);
+    CHECK(sign_of(limb.compare("18446744073709551617")) == -1);
+    CHECK(sign_of(limb.compare("+0000018446744073709551617")) == -1);
+    CHECK(sign_of((-limb).compare("-18446744073709551617")) == 1);
+    CHECK(sign_of(limb.compare("-99999999999999999999999")) == 1);
+    CHECK(sign_of(limb.compare("1000000000000000000000")) == -1);
+    CHECK(sign_of(limb.compare("9999999999999999999")) == 1);
+
+    // zero in every spelling, which is never negative
+    for (const char* zero : {"0", "-0", "+000", "-0000"}) {
+        CHECK(BigInt(0).compare(zero) == 0);
+        CHECK(sign_of(BigInt(-1).compare(zero)) == -1);
+        CHECK(sign_of(BigInt(1).compare(zero)) == 1);
+    }
+
+    CHECK_THROWS(BigInt(1).compare("12a"), std::invalid_argument);
+    CHECK_THROWS(BigInt(1).compare("--1"), std::invalid_argument);
+    CHECK_THROWS(BigInt(1) < std::string("1.5"), std::invalid_argument);
+
+    std::string text = "123";
+    CHECK(BigInt(123) == text and text <= BigInt(123) and "124" > BigInt(123));
+    CHECK((BigInt(123) <=> std::string_view("-123")) ==
+          std::strong_ordering::greater);
+}
+
+void test_against_bigints() {
+    // every pair of nearby values agrees with the comparison of BigInts, in
+    // particular where the bit length and the digit count overlap
+    DigitSource source(19);
+    for (size_t length : {1, 19, 20, 39, 40, 100, 1000}) {
+        BigInt num(source.digits(length));
+        for (const BigInt& base : {num, -num, pow(BigInt(10), length)}) {
+            for (int delta : {-1, 0, 1}) {
+                BigInt other = base + delta;
+                std::string text = other.to_string();
+                int expected = other < base ? 1 : other == base ? 0 : -1;
+                CHECK(sign_of(base.compare(other)) == expected);
+                CHECK(sign_of(base.compare(text)) == expected);
+                CHECK((base < text) == (expected < 0));
+                CHECK((text >= base) == (expected <= 0));
+            }
+        }
+    }
+}
+
+int main() {
+    test_integers();
+    test_strings();
+    test_against_bigints();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,101 @@
+/*
+    Division by multi-limb divisors: known quotients, including operands that
+    make the quotient estimate overshoot, and the division identity for
+    operands of many shapes.
+*/
+
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+// Checks a / b == quotient and a % b == remainder, for every sign of a and b
+void check_division(const std::string& dividend, const std::string& divisor,
+                    const std::string& quotient,
+                    const std::string& remainder) {
+    BigInt a(dividend), b(divisor);
+    CHECK_EQ((a / b).to_string(), quotient);
+    CHECK_EQ((a % b).to_string(), remainder);
+    CHECK(-a / b == -BigInt(quotient) and -a % b == -BigInt(remainder));
+    CHECK(a / -b == -BigInt(quotient) and a % -b == BigInt(remainder));
+}
+
+// Checks q * b + r == a with |r| < |b| and r taking the sign of a
+void check_identity(const BigInt& dividend, const BigInt& divisor) {
+    BigInt quotient = dividend / divisor;
+    BigInt remainder = dividend % divisor;
+    CHECK(quotient * divisor + remainder == dividend);
+    CHECK(abs(remainder) < abs(divisor));
+    CHECK(remainder == 0 or (remainder < 0) == (dividend < 0));
+}
+
+void test_known_quotients() {
+    // the first estimate of a quotient limb is one too large, which only
+    // shows after multiplying back, and the divisor is added back
+    check_division(
+        "57896044618658097705508390768957273162799202909612615603663330047639"
+        "949410306",
+        "3138550867693340381917894711603833208069624466305726808062",
+        "18446744073709551613",
+        "3138550867693340381577612344682894744716930323316215906300");
+    check_division(
+        "11579208923731619541101678153791454632576854700268570043896611367862"
+        "7235168256",
+        "6277101735386680763495507056286727952631112092112490176739",
+        "18446744073709551614",
+        "6277101735386680763470518596542671090361908886215932461510");
+    check_division(
+        "10679935179604550410817187638474598618966125813757985194120984698820"
+        "13236562688472176612914233344",
+        "3138550867693340381577612344682894744652366719058232475647",
+        "340282366920938463463374607431768211455",
+        "340282366920938463583278443910880296959");
+
+    // divisors with the top bit set, and just below a power of two
+    check_division("340282366920938463463374607431768211455",
+                   "18446744073709551616", "18446744073709551615",
+                   "18446744073709551615");
+    check_division("340282366920938463463374607431768211456",
+                   "340282366920938463463374607431768211455", "1", "1");
+    check_division("115792089237316195423570985008687907853269984665640564039"
+                   "457584007913129639935",
+                   "340282366920938463463374607431768211455",
+                   "340282366920938463463374607431768211457", "0");
+}
+
+void test_identity() {
+    DigitSource source(10);
+    for (size_t length1 : {40, 100, 500, 2000})
+        for (size_t length2 : {20, 39, 60, 250, 1000, 2000}) {
+            if (length2 > length1) continue;
+            BigInt dividend(source.digits(length1));
+            check_identity(dividend, BigInt(source.digits(length2)));
+            check_identity(-dividend, BigInt(source.nines(length2)));
+        }
+
+    // dividends and divisors made of all-ones and all-zeros limbs
+    BigInt limb = pow(BigInt(2), 64);
+    for (int high1 = 2; high1 <= 8; high1 += 3)
+        for (int high2 = 2; high2 <= high1; high2++) {
+            BigInt dividend = pow(limb, high1) - 1;
+            check_identity(dividend, pow(limb, high2) - 1);
+            check_identity(dividend, pow(limb, high2 - 1) + 1);
+            check_identity(pow(limb, high1), pow(limb, high2 - 1) * 2 - 1);
+        }
+
+    // a divisor times a known quotient, plus a known remainder
+    BigInt divisor(source.digits(300));
+    BigInt quotient(source.nines(200));
+    CHECK((divisor * quotient + 12345) / divisor == quotient);
+    CHECK((divisor * quotient + divisor - 1) % divisor == divisor - 1);
+}
+
+int main() {
+    test_known_quotients();
+    test_identity();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,77 @@
+/*
+    divmod and divmod_floor: the rounding of the quotient and the sign of the
+    remainder for every combination of operand signs.
+*/
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+// Checks divmod and divmod_floor of a by b against the expected results
+void check_divmod(const BigInt& a, const BigInt& b,
+                  const std::string& quotient, const std::string& remainder,
+                  const std::string& floor_quotient,
+                  const std::string& floor_remainder) {
+    BigInt q, r;
+    std::tie(q, r) = divmod(a, b);
+    CHECK_EQ(q.to_string(), quotient);
+    CHECK_EQ(r.to_string(), remainder);
+    std::tie(q, r) = divmod_floor(a, b);
+    CHECK_EQ(q.to_string(), floor_quotient);
+    CHECK_EQ(r.to_string(), floor_remainder);
+}
+
+void test_signs() {
+    check_divmod(7, 2, "3", "1", "3", "1");
+    check_divmod(-7, 2, "-3", "-1", "-4", "1");
+    check_divmod(7, -2, "-3", "1", "-4", "-1");
+    check_divmod(-7, -2, "3", "-1", "3", "-1");
+    check_divmod(-6, 2, "-3", "0", "-3", "0");
+    check_divmod(0, -5, "0", "0", "0", "0");
+    check_divmod(3, 5, "0", "3", "0", "3");
+    check_divmod(-3, 5, "0", "-3", "-1", "2");
+
+    BigInt big("-340282366920938463463374607431768211457");  // -(2^128 + 1)
+    BigInt limb("18446744073709551616");                      // 2^64
+    check_divmod(big, limb, "-18446744073709551616", "-1",
+                 "-18446744073709551617", "18446744073709551615");
+    check_divmod(big, -limb, "18446744073709551616", "-1",
+                 "18446744073709551616", "-1");
+    check_divmod(-big, -limb, "-18446744073709551616", "1",
+                 "-18446744073709551617", "-18446744073709551615");
+
+    CHECK_THROWS(divmod(BigInt(1), BigInt(0)), std::logic_error);
+    CHECK_THROWS(divmod_floor(BigInt(1), BigInt(0)), std::logic_error);
+}
+
+void test_consistency() {
+    // divmod agrees with / and %, and both forms satisfy q * b + r == a
+    DigitSource source(13);
+    for (size_t length1 : {5, 30, 200, 1500})
+        for (size_t length2 : {3, 25, 150}) {
+            BigInt a(source.digits(length1)), b(source.nines(length2));
+            for (const BigInt& dividend : {a, -a})
+                for (const BigInt& divisor : {b, -b}) {
+                    BigInt q, r;
+                    std::tie(q, r) = divmod(dividend, divisor);
+                    CHECK(q == dividend / divisor and r == dividend % divisor);
+                    std::tie(q, r) = divmod_floor(dividend, divisor);
+                    CHECK(q * divisor + r == dividend);
+                    CHECK(r == 0 or (r < 0) == (divisor < 0));
+                    CHECK(abs(r) < abs(divisor));
+                }
+        }
+}
+
+int main() {
+    test_signs();
+    test_consistency();
+
+    return numericxx::test::finish();
+}
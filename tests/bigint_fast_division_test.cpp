@@ -0,0 +1,84 @@
+/*
+    Burnikel-Ziegler and Newton reciprocal division, with the thresholds
+    lowered so that moderate operands take both recursive paths, checked
+    against products with known remainders and the division identity.
+*/
+
+#define NUMERICXX_BIGINT_KARATSUBA_THRESHOLD 4
+#define NUMERICXX_BIGINT_TOOM3_THRESHOLD 8
+#define NUMERICXX_BIGINT_TOOM4_THRESHOLD 16
+#define NUMERICXX_BIGINT_BZ_THRESHOLD 4
+#define NUMERICXX_BIGINT_NEWTON_DIV_THRESHOLD 40
+
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+// Checks that (divisor * quotient + remainder) splits back into its parts,
+// for every sign of the dividend and divisor
+void check_known(const BigInt& divisor, const BigInt& quotient,
+                 const BigInt& remainder) {
+    BigInt dividend = divisor * quotient + remainder;
+    CHECK(dividend / divisor == quotient);
+    CHECK(dividend % divisor == remainder);
+    CHECK(-dividend / divisor == -quotient);
+    CHECK(-dividend % divisor == -remainder);
+    CHECK(dividend / -divisor == -quotient);
+    CHECK(dividend % -divisor == remainder);
+}
+
+void test_known_quotients() {
+    // divisor sizes on either side of each threshold and quotients shorter
+    // and longer than the divisor; 19 digits is a little over one limb
+    DigitSource source(11);
+    for (size_t divisor_length : {60, 100, 300, 760, 800, 1600, 3000})
+        for (size_t quotient_length : {50, 400, 1000, 4000}) {
+            BigInt divisor(source.digits(divisor_length));
+            BigInt quotient(source.digits(quotient_length));
+            check_known(divisor, quotient, divisor - 1);
+            check_known(divisor, quotient, BigInt(source.nines(30)));
+            check_known(divisor, quotient, 0);
+        }
+
+    // divisors that need no normalisation, and all-ones divisors
+    BigInt limb = pow(BigInt(2), 64);
+    for (int limbs : {5, 41, 80, 150}) {
+        BigInt top_bit = pow(limb, limbs) / 2 + 12345;
+        check_known(top_bit, pow(limb, limbs + 3) - 1, top_bit - 1);
+        BigInt ones = pow(limb, limbs) - 1;
+        check_known(ones, ones, ones - 1);
+        check_known(ones, pow(limb, 2 * limbs + 1) + 1, 1);
+    }
+}
+
+void test_identity() {
+    DigitSource source(12);
+    for (size_t length1 : {200, 1000, 3000, 6000})
+        for (size_t length2 : {80, 150, 500, 1000, 3000}) {
+            if (length2 > length1) continue;
+            BigInt dividend(source.nines(length1));
+            BigInt divisor(source.digits(length2));
+            BigInt quotient = dividend / divisor;
+            BigInt remainder = dividend % divisor;
+            CHECK(quotient * divisor + remainder == dividend);
+            CHECK(remainder >= 0 and remainder < divisor);
+        }
+
+    // 10^6000 / (10^1500 - 1) = sum of 10^(1500k) for k = 1..3, remainder 1
+    BigInt divisor = pow(BigInt(10), 1500) - 1;
+    BigInt quotient = pow(BigInt(10), 4500) + pow(BigInt(10), 3000) +
+                      pow(BigInt(10), 1500) + 1;
+    CHECK(pow(BigInt(10), 6000) / divisor == quotient);
+    CHECK(pow(BigInt(10), 6000) % divisor == 1);
+}
+
+int main() {
+    test_known_quotients();
+    test_identity();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,72 @@
+/*
+    Lazy expressions evaluate to the same values as the eager operators:
+    sums of products of every sign, integer operands, negation, nested
+    factors, and updates and assignments that refer to their own target.
+*/
+
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+void test_values() {
+    DigitSource source(22);
+    for (size_t length : {1, 20, 300, 2000}) {
+        BigInt a(source.digits(length));
+        BigInt b = -BigInt(source.nines(length / 2 + 1));
+        BigInt c(source.digits(length + 7)), d(source.digits(3)), e(-7);
+
+        BigInt result = lazy(a) * b - lazy(c) * d + e;
+        CHECK(result == a * b - c * d + e);
+        result = lazy(a) * 5 + lazy(b) * -3 - 11;
+        CHECK(result == a * 5 + b * -3 - 11);
+        result = -(lazy(a) * c) - (lazy(b) - d) + 2 * lazy(e);
+        CHECK(result == -(a * c) - (b - d) + 2 * e);
+        result = (lazy(a) + b) * (lazy(c) - d) - lazy(a) * lazy(a);
+        CHECK(result == (a + b) * (c - d) - a * a);
+
+        // the terms cancel exactly
+        result = lazy(a) * c - lazy(c) * a;
+        CHECK_EQ(result.to_string(), "0");
+    }
+}
+
+void test_self_reference() {
+    DigitSource source(23);
+    BigInt a(source.digits(400)), b(source.digits(350));
+    BigInt c(source.nines(200)), d(-BigInt(source.digits(250)));
+
+    // updates that add terms to the target in place, by assignment and
+    // through evaluate_into
+    BigInt r(source.digits(900));
+    BigInt expected = r + a * b - c * d;
+    r = lazy(r) + lazy(a) * b - lazy(c) * d;
+    CHECK(r == expected);
+    expected = expected - a * c + 1;
+    evaluate_into(r, lazy(r) - lazy(a) * c + 1);
+    CHECK(r == expected);
+
+    // expressions that use the target elsewhere are evaluated aside
+    expected = a * expected - expected;
+    r = lazy(a) * r - r;
+    CHECK(r == expected);
+    expected = -(expected * expected) + b;
+    r = -(lazy(r) * r) + b;
+    CHECK(r == expected);
+
+    BigInt target = 5;
+    evaluate_into(target, lazy(a) * b);
+    CHECK(target == a * b);
+    target = lazy(c) - c;
+    CHECK_EQ(target.to_string(), "0");
+}
+
+int main() {
+    test_values();
+    test_self_reference();
+
+    return numericxx::test::finish();
+}
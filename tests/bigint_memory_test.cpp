@@ -0,0 +1,126 @@
+/*
+    BigIntMemoryScope and the scratch arena: limbs come from the installed
+    resource and go back to it, scopes nest, and storage that outlives a
+    scope (the cached radix powers, the arena blocks) never comes from it.
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::BigIntMemoryScope;
+using numericxx::test::DigitSource;
+
+// Counts the bytes allocated through it and not yet returned
+class CountingResource : public std::pmr::memory_resource {
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        outstanding += bytes;
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+   public:
+    size_t outstanding = 0, allocations = 0;
+};
+
+void test_arena_destroyed() {
+    // the first conversions of long numbers on this thread happen in a scope
+    // over a buffer that is wiped afterwards, as if the arena were freed
+    DigitSource source(24);
+    std::string decimal = source.digits(6000);
+    std::string septenary;
+    static std::byte buffer[1 << 20];
+    {
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+        BigIntMemoryScope scope(&arena);
+        BigInt num(decimal);
+        CHECK_EQ(num.to_string(), decimal);
+        septenary.resize(to_chars_size(num, 7));
+        septenary.resize(
+            to_chars(septenary.data(), septenary.data() + septenary.size(),
+                     num, 7).ptr - septenary.data());
+        BigInt product = num * num;
+        CHECK(product / num == num);
+    }
+    std::memset(buffer, 0xa5, sizeof(buffer));
+
+    BigInt num(decimal);
+    CHECK_EQ(num.to_string(), decimal);
+    BigInt parsed;
+    from_chars(septenary.data(), septenary.data() + septenary.size(), parsed,
+               7);
+    CHECK(parsed == num);
+    CHECK((num * num) / num == num);
+}
+
+void test_scopes() {
+    DigitSource source(25);
+    std::string digits = source.digits(2000);
+    CountingResource outer, inner;
+    {
+        BigIntMemoryScope outer_scope(&outer);
+        BigInt a(digits);
+        CHECK(outer.outstanding > 0);
+        size_t outer_allocations = outer.allocations;
+        {
+            BigIntMemoryScope inner_scope(&inner);
+            BigInt b = a * a;
+            CHECK(inner.outstanding > 0);
+            CHECK(b / a == a);
+            {
+                BigIntMemoryScope global_heap(nullptr);
+                size_t before = inner.allocations;
+                BigInt c = a + a;
+                CHECK(inner.allocations == before and c == 2 * a);
+            }
+        }
+        CHECK(inner.outstanding == 0);
+
+        // after the inner scope ends, new limbs come from the outer one again
+        BigInt d = a - 1;
+        CHECK(outer.allocations > outer_allocations);
+
+        // small values stay inline and never reach the resource
+        size_t before = outer.allocations;
+        BigInt small = BigInt(123456789) * 1000;
+        small += pow(BigInt(2), 100);
+        CHECK(outer.allocations == before);
+        CHECK(d + 1 == a and small > 0);
+    }
+    CHECK(outer.outstanding == 0);
+
+    // a copy taken after the scope holds limbs from the global heap
+    BigInt copy;
+    {
+        CountingResource resource;
+        {
+            BigIntMemoryScope scope(&resource);
+            BigInt num(digits);
+            {
+                BigIntMemoryScope global_heap(nullptr);
+                copy = num;
+            }
+        }
+        CHECK(resource.outstanding == 0);
+    }
+    CHECK_EQ(copy.to_string(), digits);
+}
+
+int main() {
+    test_arena_destroyed();
+    test_scopes();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,122 @@
+/*
+    Montgomery arithmetic for u64, u128 and BigInt moduli, checked against
+    products and sums reduced with the BigInt remainder, including moduli
+    that use the full width of the word and multi-limb moduli.
+*/
+
+#include <stdexcept>
+#include <tuple>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::MontgomeryContext;
+using numericxx::SplitMix64;
+using numericxx::u128;
+using numericxx::u64;
+using numericxx::test::DigitSource;
+
+// The value of a u128 as a BigInt, built from 32-bit pieces
+BigInt to_bigint(u128 num) {
+    BigInt value;
+    for (int shift = 96; shift >= 0; shift -= 32)
+        mul_word_add(value, 4294967296,
+                     (long long)(u64(num >> shift) & 0xffffffff));
+    return value;
+}
+
+// the whole computation can run at compile time
+constexpr MontgomeryContext<u64> SMALL(1000000007);
+constexpr u64 SMALL_PRODUCT = SMALL.from_montgomery(
+    SMALL.mul(SMALL.to_montgomery(123456789), SMALL.to_montgomery(987654321)));
+static_assert(SMALL_PRODUCT == u64(123456789) * 987654321 % 1000000007);
+
+void test_u64() {
+    SplitMix64 engine(1);
+    for (u64 modulus : {u64(3), u64(1000000007), (u64(1) << 63) + 1,
+                        u64(0) - 59, u64(0) - 1}) {
+        MontgomeryContext<u64> context(modulus);
+        CHECK(context.modulus() == modulus);
+        CHECK(context.from_montgomery(context.one()) == 1 % modulus);
+        for (int i = 0; i < 200; i++) {
+            u64 a = engine(), b = engine() % modulus;
+            u64 ma = context.to_montgomery(a), mb = context.to_montgomery(b);
+            CHECK(ma < modulus and context.from_montgomery(ma) == a % modulus);
+            CHECK(context.from_montgomery(context.mul(ma, mb)) ==
+                  u128(a % modulus) * b % modulus);
+            CHECK(context.from_montgomery(context.add(ma, mb)) ==
+                  (u128(a % modulus) + b) % modulus);
+            CHECK(context.from_montgomery(context.sub(ma, mb)) ==
+                  (u128(a % modulus) + modulus - b) % modulus);
+        }
+    }
+    CHECK_THROWS(MontgomeryContext<u64>(1000), std::invalid_argument);
+}
+
+void test_u128() {
+    SplitMix64 engine(2);
+    for (u128 modulus : {u128(5), (u128(1) << 64) + 13, u128(0) - 159,
+                         u128(0) - 1}) {
+        MontgomeryContext<u128> context(modulus);
+        BigInt big_modulus = to_bigint(modulus);
+        for (int i = 0; i < 200; i++) {
+            u128 a = u128(engine()) << 64 | engine();
+            u128 b = (u128(engine()) << 64 | engine()) % modulus;
+            u128 ma = context.to_montgomery(a), mb = context.to_montgomery(b);
+            CHECK(context.from_montgomery(ma) == a % modulus);
+            CHECK(to_bigint(context.from_montgomery(context.mul(ma, mb))) ==
+                  to_bigint(a % modulus) * to_bigint(b) % big_modulus);
+            CHECK(to_bigint(context.from_montgomery(context.add(ma, mb))) ==
+                  (to_bigint(a % modulus) + to_bigint(b)) % big_modulus);
+            CHECK(context.from_montgomery(context.sub(mb, mb)) == 0);
+        }
+    }
+    CHECK_THROWS(MontgomeryContext<u128>(u128(1) << 100),
+                 std::invalid_argument);
+}
+
+void test_bigint() {
+    SplitMix64 engine(3);
+    DigitSource source(26);
+    // moduli of about half of R leave many reduced products in [m, R)
+    for (const BigInt& modulus :
+         {BigInt(1000000007), pow(BigInt(2), 127) - 1, pow(BigInt(2), 127) + 1,
+          pow(BigInt(2), 640) - 1, BigInt(source.digits(2000)) * 2 + 1}) {
+        MontgomeryContext<BigInt> context(modulus);
+        CHECK(context.modulus() == modulus);
+        CHECK(context.from_montgomery(context.one()) == 1);
+        for (int i = 0; i < 20; i++) {
+            BigInt a = random_below(modulus, engine);
+            BigInt b = random_below(modulus, engine);
+            BigInt ma = context.to_montgomery(a);
+            BigInt mb = context.to_montgomery(b);
+            CHECK(ma >= 0 and ma < modulus);
+            CHECK(context.from_montgomery(ma) == a);
+            BigInt product = context.mul(ma, mb);
+            CHECK(product < modulus);
+            CHECK(context.from_montgomery(product) == a * b % modulus);
+            CHECK(context.from_montgomery(context.add(ma, mb)) ==
+                  (a + b) % modulus);
+            CHECK(context.from_montgomery(context.sub(ma, mb)) ==
+                  std::get<1>(divmod_floor(a - b, modulus)));
+        }
+
+        // the largest residues, whose product is the largest to reduce
+        BigInt top = context.to_montgomery(modulus - 1);
+        CHECK(context.from_montgomery(context.mul(top, top)) == 1);
+    }
+
+    CHECK_THROWS(MontgomeryContext<BigInt>(BigInt(1000)),
+                 std::invalid_argument);
+    CHECK_THROWS(MontgomeryContext<BigInt>(BigInt(-7)), std::invalid_argument);
+    CHECK_THROWS(MontgomeryContext<BigInt>(BigInt(0)), std::invalid_argument);
+}
+
+int main() {
+    test_u64();
+    test_u128();
+    test_bigint();
+
+    return numericxx::test::finish();
+}
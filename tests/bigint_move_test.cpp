@@ -0,0 +1,68 @@
+/*
+    Move construction and assignment, and the + and - overloads that
+    accumulate into a temporary operand.
+*/
+
+#include <string>
+#include <utility>
+
+#include "check.hpp"
+#include "utils/BigInt.hpp"
+
+void test_moves() {
+    BigInt num("-340282366920938463463374607431768211456");
+    BigInt moved(std::move(num));
+    CHECK_EQ(moved.to_string(), "-340282366920938463463374607431768211456");
+    CHECK_EQ(num.to_string(), "0");
+
+    num = std::move(moved);
+    CHECK_EQ(num.to_string(), "-340282366920938463463374607431768211456");
+    CHECK_EQ(moved.to_string(), "0");
+
+    // the moved-from object is still usable
+    moved += 41;
+    CHECK_EQ((moved + 1).to_string(), "42");
+}
+
+void test_temporary_operands() {
+    BigInt num1("18446744073709551615");
+    BigInt num2("-18446744073709551616");
+
+    // each combination of temporary and named operands
+    CHECK_EQ((num1 + num2).to_string(), "-1");
+    CHECK_EQ((BigInt(num1) + num2).to_string(), "-1");
+    CHECK_EQ((num1 + BigInt(num2)).to_string(), "-1");
+    CHECK_EQ((BigInt(num1) + BigInt(num2)).to_string(), "-1");
+    CHECK_EQ((BigInt(num1) - num2).to_string(), "36893488147419103231");
+    CHECK_EQ((num1 - BigInt(num2)).to_string(), "36893488147419103231");
+    CHECK_EQ((BigInt(num1) - BigInt(num2)).to_string(),
+             "36893488147419103231");
+    CHECK_EQ((-BigInt(num2)).to_string(), "18446744073709551616");
+
+    // a short temporary added to a long one, in both orders
+    BigInt longer = pow(BigInt(2), 300);
+    CHECK_EQ((BigInt(7) + BigInt(longer) - longer).to_string(), "7");
+    CHECK_EQ((BigInt(longer) + BigInt(7) - longer).to_string(), "7");
+
+    // integer and string operands on a temporary; these used to be
+    // ambiguous with the BigInt overloads
+    CHECK_EQ((num1 * num1 + 1).to_string(),
+             "340282366920938463426481119284349108226");
+    CHECK_EQ((num1 * num1 - 1).to_string(),
+             "340282366920938463426481119284349108224");
+    CHECK_EQ((num1 * 2 + std::string("2")).to_string(),
+             "36893488147419103232");
+    CHECK_EQ((num1 * 2 - std::string("-2")).to_string(),
+             "36893488147419103232");
+
+    // a chain of temporaries
+    BigInt sum = BigInt(1) + num1 + num1 + num2 - num1 + 5;
+    CHECK_EQ(sum.to_string(), "5");
+}
+
+int main() {
+    test_moves();
+    test_temporary_operands();
+
+    return numericxx::test::finish();
+}
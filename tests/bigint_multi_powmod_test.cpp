@@ -0,0 +1,67 @@
+/*
+    multi_powmod against the product of separate powmod calls, for numbers
+    of bases on either side of the switch from Straus's method to
+    Pippenger's, odd and even moduli, and the edge cases of the arguments.
+*/
+
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::SplitMix64;
+using numericxx::test::DigitSource;
+
+// The product of bases[i]^exps[i] mod modulus, one power at a time
+BigInt separate_powmod(const std::vector<BigInt>& bases,
+                       const std::vector<BigInt>& exps,
+                       const BigInt& modulus) {
+    BigInt result = 1 % modulus;
+    for (size_t i = 0; i < bases.size(); i++)
+        result = result * powmod(bases[i], exps[i], modulus) % modulus;
+    return result;
+}
+
+void test_against_separate() {
+    SplitMix64 engine(35);
+    DigitSource source(36);
+    BigInt odd(source.digits(80));
+    odd += 1 - odd % 2;
+    BigInt offset = pow(BigInt(2), 299);  // makes about half the bases negative
+    for (const BigInt& modulus : {odd, odd * 4, BigInt(1000000007)})
+        for (size_t count : {1, 2, 5, 40, 1500})
+            for (size_t exp_bits : {1, 20, 300}) {
+                std::vector<BigInt> bases, exps;
+                for (size_t i = 0; i < count; i++) {
+                    bases.push_back(random_bits(300, engine) - offset);
+                    exps.push_back(random_bits(exp_bits, engine));
+                }
+                exps[0] = 0;  // skipped, whatever the base
+                CHECK(multi_powmod(bases, exps, modulus) ==
+                      separate_powmod(bases, exps, modulus));
+            }
+}
+
+void test_edge_cases() {
+    CHECK(multi_powmod({}, {}, 7) == 1);
+    CHECK(multi_powmod({}, {}, 1) == 0);
+    CHECK(multi_powmod({2, 3}, {0, 0}, 7) == 1);
+    CHECK(multi_powmod({2, 3, 5}, {10, 20, 30}, 1000000007) ==
+          BigInt(1024) * pow(BigInt(3), 20) * pow(BigInt(5), 30) % 1000000007);
+    CHECK(multi_powmod({0, 3}, {5, 1}, 7) == 0);
+
+    CHECK_THROWS(multi_powmod({2, 3}, {1}, 7), std::invalid_argument);
+    CHECK_THROWS(multi_powmod({2}, {-1}, 7), std::invalid_argument);
+    CHECK_THROWS(multi_powmod({0, 2}, {0, 1}, 7), std::logic_error);
+    CHECK_THROWS(multi_powmod({2}, {1}, 0), std::logic_error);
+    CHECK_THROWS(multi_powmod({2}, {1}, -7), std::invalid_argument);
+}
+
+int main() {
+    test_against_separate();
+    test_edge_cases();
+
+    return numericxx::test::finish();
+}
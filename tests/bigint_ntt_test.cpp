@@ -0,0 +1,56 @@
+/*
+    Three-prime NTT multiplication, with the threshold lowered so that
+    moderate operands are convolved, checked against the reference product
+    and against the largest coefficients a convolution can produce.
+*/
+
+#define NUMERICXX_BIGINT_KARATSUBA_THRESHOLD 4
+#define NUMERICXX_BIGINT_TOOM3_THRESHOLD 8
+#define NUMERICXX_BIGINT_TOOM4_THRESHOLD 12
+#define NUMERICXX_BIGINT_NTT_THRESHOLD 16
+
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+using numericxx::test::multiply_decimal;
+
+void test_products() {
+    DigitSource source(7);
+    for (size_t length1 : {310, 620, 1000, 3000})
+        for (size_t length2 : {310, 500, 1000, 3000}) {
+            if (length2 > length1) continue;
+            std::string num1 = source.digits(length1);
+            std::string num2 = source.nines(length2);
+            std::string product = multiply_decimal(num1, num2);
+            CHECK_EQ((BigInt(num1) * BigInt(num2)).to_string(), product);
+            CHECK(BigInt(num1) * -BigInt(num2) == -BigInt(product));
+        }
+}
+
+void test_large_coefficients() {
+    // all-ones digits make every coefficient of the convolution as large as
+    // its length allows, which needs all three primes to recover
+    for (size_t limbs : {16, 17, 100, 1000, 4000}) {
+        BigInt ones = pow(BigInt(2), 64 * limbs) - 1;
+        BigInt square = pow(BigInt(2), 128 * limbs) -
+                        pow(BigInt(2), 64 * limbs + 1) + 1;
+        CHECK(ones * ones == square);
+        CHECK(ones * (ones + 2) == square + 2 * ones);
+    }
+
+    // products that are exact powers, whose carries run the full length
+    BigInt power = pow(BigInt(3), 20000);
+    CHECK(power * power == pow(BigInt(9), 20000));
+    CHECK(power * pow(BigInt(3), 10000) == pow(BigInt(27), 10000));
+}
+
+int main() {
+    test_products();
+    test_large_coefficients();
+
+    return numericxx::test::finish();
+}
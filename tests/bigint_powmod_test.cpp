@@ -0,0 +1,152 @@
+/*
+    powmod and FixedBasePowmod for odd and even moduli, with the threshold of
+    Montgomery reduction by multiplication lowered so that both reductions
+    run, checked against known powers, Fermat's little theorem and a plain
+    square-and-multiply loop.
+*/
+
+#define NUMERICXX_BIGINT_REDC_THRESHOLD 4
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::MontgomeryContext;
+using numericxx::SplitMix64;
+using numericxx::u128;
+using numericxx::u64;
+using numericxx::test::DigitSource;
+
+// base^exp mod modulus by binary exponentiation with a remainder per step
+BigInt slow_powmod(BigInt base, BigInt exp, const BigInt& modulus) {
+    BigInt result = 1 % modulus;
+    base = std::get<1>(divmod_floor(base, modulus));
+    for (size_t i = 0; i < exp.bit_length(); i++) {
+        if (exp.test_bit(i)) result = result * base % modulus;
+        base = base * base % modulus;
+    }
+    return result;
+}
+
+void test_known_values() {
+    CHECK_EQ(powmod(2, pow(BigInt(10), 20), 1000000007).to_string(),
+             "855473248");
+    CHECK_EQ(powmod(-3, 101, 1000).to_string(), "997");
+    CHECK_EQ(powmod(7, 12345, pow(BigInt(2), 100)).to_string(),
+             "961162713373288692133717306055");
+    CHECK_EQ(powmod(123456789, 987654321, pow(BigInt(10), 30)).to_string(),
+             "909077141664922883132974933589");
+    CHECK(powmod(5, 0, 7) == 1 and powmod(5, 0, 1) == 0);
+    CHECK(powmod(0, 10, 7) == 0 and powmod(12345, 678, 1) == 0);
+
+    CHECK_THROWS(powmod(0, 0, 7), std::logic_error);
+    CHECK_THROWS(powmod(2, 3, 0), std::logic_error);
+    CHECK_THROWS(powmod(2, -1, 7), std::invalid_argument);
+    CHECK_THROWS(powmod(2, 3, -7), std::invalid_argument);
+}
+
+void test_word_contexts() {
+    constexpr MontgomeryContext<u64> small(1000000007);
+    static_assert(small.from_montgomery(small.pow(
+                      small.to_montgomery(2), 1000000000000000000)) ==
+                  719476260);
+
+    MontgomeryContext<u128> wide((u128(1) << 127) - 1);
+    u128 power = wide.from_montgomery(
+        wide.pow(wide.to_montgomery(3), (u128(1) << 100) + 7));
+    CHECK(power == (u128(0x1b05a6dc0d646d0a) << 64 | 0x2c72f7da985c4e98));
+    CHECK(wide.pow(wide.to_montgomery(5), 0) == wide.one());
+}
+
+void test_fermat() {
+    // Mersenne primes on either side of the lowered threshold
+    for (int exp : {61, 127, 521, 1279, 2203}) {
+        BigInt prime = pow(BigInt(2), exp) - 1;
+        MontgomeryContext<BigInt> context(prime);
+        for (long long base : {2, 3, 10, -7}) {
+            CHECK(powmod(base, prime - 1, prime) == 1);
+            CHECK(powmod(base, prime - 1, context) == 1);
+            CHECK(powmod(base, prime, context) ==
+                  std::get<1>(divmod_floor(BigInt(base), prime)));
+        }
+    }
+}
+
+void test_reduction_range() {
+    // Montgomery products end below the modulus, whether they are reduced a
+    // limb at a time or by multiplication; with the modulus about half of R,
+    // the reduced value often falls in [modulus, R) and needs the final
+    // subtraction without overflowing
+    SplitMix64 engine(34);
+    for (const BigInt& modulus :
+         {pow(BigInt(2), 127) + 1, pow(BigInt(2), 639) + 1}) {
+        MontgomeryContext<BigInt> context(modulus);
+        for (int i = 0; i < 100; i++) {
+            BigInt a = random_below(modulus, engine);
+            BigInt b = random_below(modulus, engine);
+            BigInt product =
+                context.mul(context.to_montgomery(a), context.to_montgomery(b));
+            CHECK(product < modulus);
+            CHECK(context.from_montgomery(product) == a * b % modulus);
+        }
+    }
+}
+
+void test_against_slow() {
+    SplitMix64 engine(30);
+    DigitSource source(31);
+    BigInt odd(source.digits(200));
+    odd += 1 - odd % 2;
+    for (const BigInt& modulus :
+         {BigInt(3), BigInt(1000000007), pow(BigInt(2), 64) + 1, odd,
+          odd * 2, odd * 1024, pow(BigInt(2), 300), odd * odd}) {
+        for (size_t exp_bits : {1, 5, 64, 300, 1000}) {
+            BigInt base = random_bits(modulus.bit_length() + 10, engine);
+            BigInt exp = random_bits(exp_bits, engine);
+            BigInt expected = slow_powmod(base, exp, modulus);
+            CHECK(powmod(base, exp, modulus) == expected);
+            CHECK(powmod(-base, exp, modulus) ==
+                  slow_powmod(-base, exp, modulus));
+        }
+    }
+}
+
+void test_fixed_base() {
+    SplitMix64 engine(32);
+    DigitSource source(33);
+    BigInt odd(source.digits(150));
+    odd += 1 - odd % 2;
+    for (const BigInt& modulus : {odd, odd * 8, BigInt(1000000007)}) {
+        BigInt base = random_below(modulus, engine);
+        FixedBasePowmod fixed(base, modulus);
+        FixedBasePowmod narrow(base, modulus, 100, 3);
+        for (size_t exp_bits : {0, 1, 63, 100, 101, 498, 1200}) {
+            BigInt exp = random_bits(exp_bits, engine);
+            BigInt expected = powmod(base, exp, modulus);
+            CHECK(fixed.pow(exp) == expected);
+            CHECK(narrow.pow(exp) == expected);
+        }
+        CHECK(fixed.pow(0) == 1 and fixed.pow(1) == base);
+        CHECK_THROWS(fixed.pow(-1), std::invalid_argument);
+    }
+
+    FixedBasePowmod zero(0, 101);
+    CHECK(zero.pow(5) == 0);
+    CHECK_THROWS(zero.pow(0), std::logic_error);
+    CHECK_THROWS(FixedBasePowmod(2, 0), std::logic_error);
+}
+
+int main() {
+    test_known_values();
+    test_word_contexts();
+    test_fermat();
+    test_reduction_range();
+    test_against_slow();
+    test_fixed_base();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,93 @@
+/*
+    Divide-and-conquer conversion between limbs and digit strings, with the
+    threshold lowered so that short numbers are split as well, checked
+    against values built arithmetically and by round trips in every base.
+*/
+
+#define NUMERICXX_BIGINT_RADIX_THRESHOLD 2
+
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::detail::digits_size;
+using numericxx::detail::digits_to_limbs;
+using numericxx::detail::LimbVector;
+using numericxx::detail::limbs_to_digits;
+using numericxx::test::DigitSource;
+
+// Converts a magnitude to digits in a base
+std::string to_digits(const LimbVector& num, unsigned base) {
+    std::string digits(digits_size(num, base), '\0');
+    char* end = limbs_to_digits(digits.data(), num, base);
+    digits.resize(end - digits.data());
+    return digits.empty() ? "0" : digits;
+}
+
+void test_decimal() {
+    // powers of ten and their neighbours, whose digits are all zeros or nines
+    for (int exp : {18, 19, 20, 38, 39, 100, 1000, 4000}) {
+        BigInt power = pow(BigInt(10), exp);
+        CHECK_EQ(power.to_string(), "1" + std::string(exp, '0'));
+        CHECK_EQ((power - 1).to_string(), std::string(exp, '9'));
+        CHECK_EQ((power + 1).to_string(),
+                 "1" + std::string(exp - 1, '0') + "1");
+        CHECK(BigInt("1" + std::string(exp, '0')) == power);
+        CHECK(BigInt(std::string(exp, '9')) == power - 1);
+        CHECK(big_pow10(exp) == power);
+    }
+
+    // round trips of every length around the chunk and split sizes
+    DigitSource source(15);
+    for (size_t length = 1; length < 200; length++) {
+        std::string num = source.digits(length);
+        CHECK_EQ(BigInt(num).to_string(), num);
+    }
+    for (size_t length : {1000, 1024, 5000}) {
+        std::string num = source.nines(length);
+        CHECK_EQ(BigInt(num).to_string(), num);
+        CHECK_EQ(BigInt("-" + num).to_string(), "-" + num);
+    }
+
+    // leading zeros are dropped, and the padding of each half is kept
+    CHECK_EQ(BigInt(std::string(500, '0') + "42").to_string(), "42");
+    BigInt padded = pow(BigInt(10), 300) * 7 + 3;
+    CHECK_EQ(padded.to_string(), "7" + std::string(299, '0') + "3");
+}
+
+void test_bases() {
+    LimbVector power = digits_to_limbs("16069380442589902755419620923411626025"
+                                       "22202993782792835301376",
+                                       61, 10);  // 2^200
+    CHECK_EQ(to_digits(power, 2), "1" + std::string(200, '0'));
+    CHECK_EQ(to_digits(power, 16), "1" + std::string(50, '0'));
+    CHECK_EQ(to_digits(power, 36), "bnklg118comha6gqury14067gur54n8won6guf4");
+    CHECK_EQ(to_digits(power, 7),
+             "14124606653363264321323234405060605306144344600654436163210263"
+             "0555343054");
+
+    // letters of either case are accepted
+    LimbVector upper = digits_to_limbs("DEADBEEF", 8, 16);
+    LimbVector lower = digits_to_limbs("deadbeef", 8, 16);
+    CHECK(upper.size() == 1 and upper[0] == 0xdeadbeef and lower == upper);
+
+    // round trips in every base, through lengths that are split repeatedly
+    DigitSource source(16);
+    for (unsigned base = 2; base <= 36; base++)
+        for (size_t length : {1, 30, 200, 1500}) {
+            std::string decimal = source.digits(length);
+            LimbVector num = digits_to_limbs(decimal.data(), length, 10);
+            std::string digits = to_digits(num, base);
+            CHECK(digits_to_limbs(digits.data(), digits.size(), base) == num);
+            CHECK_EQ(to_digits(num, 10), decimal);
+        }
+}
+
+int main() {
+    test_decimal();
+    test_bases();
+
+    return numericxx::test::finish();
+}
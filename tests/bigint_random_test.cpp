@@ -0,0 +1,105 @@
+/*
+    Random BigInts from seeded engines: the SplitMix64 sequence, the exact
+    values drawn from it, the range and rough uniformity of random_below, and
+    engines narrower than a limb.
+*/
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::SplitMix64;
+
+void test_engine() {
+    // the reference SplitMix64 outputs for a seed of zero
+    SplitMix64 engine;
+    CHECK(engine() == 0xe220a8397b1dcdaf);
+    CHECK(engine() == 0x6e789e6aa1b965f4);
+    CHECK(engine() == 0x06c45d188009454f);
+
+    SplitMix64 skipped(12345), stepped(12345);
+    skipped.discard(1000);
+    for (int i = 0; i < 1000; i++) stepped();
+    CHECK(skipped() == stepped());
+    stepped.seed(12345);
+    CHECK(stepped() == SplitMix64(12345)());
+}
+
+void test_random_bits() {
+    // limbs are taken from the engine least significant first
+    SplitMix64 engine;
+    CHECK_EQ(random_bits(128, engine).to_string(),
+             "146841368228318748144968999469672418735");
+    engine.seed(0);
+    CHECK_EQ(random_bits(100, engine).to_string(),
+             "842332844476823170633405681071");
+    CHECK(random_bits(0, engine) == 0);
+
+    for (size_t bits : {1, 63, 64, 65, 1000}) {
+        BigInt limit = pow(BigInt(2), bits);
+        for (int i = 0; i < 50; i++) {
+            BigInt num = random_bits(bits, engine);
+            CHECK(num >= 0 and num < limit);
+        }
+        CHECK(random_bits(bits) < limit);
+    }
+
+    // a 32-bit engine fills each limb from two outputs
+    std::mt19937 narrow(7);
+    BigInt num = random_bits(256, narrow);
+    CHECK(num >= 0 and num.bit_length() <= 256 and num.bit_length() > 192);
+}
+
+void test_random_below() {
+    // every value of a small range is drawn about as often as the others
+    SplitMix64 engine(42);
+    int counts[6] = {};
+    for (int i = 0; i < 60000; i++) counts[random_below(6, engine).to_int()]++;
+    for (int count : counts) CHECK(count > 9000 and count < 11000);
+
+    // a bound just above a power of two rejects almost half of the draws
+    BigInt bound = pow(BigInt(2), 200) + 1;
+    bool high = false;
+    for (int i = 0; i < 200; i++) {
+        BigInt num = random_below(bound, engine);
+        CHECK(num >= 0 and num < bound);
+        high = high or num.test_bit(199);
+    }
+    CHECK(high);
+    CHECK(random_below(1, engine) == 0);
+    CHECK(random_below(BigInt(10)) < 10);
+
+    CHECK_THROWS(random_below(0, engine), std::invalid_argument);
+    CHECK_THROWS(random_below(-5, engine), std::invalid_argument);
+
+    // the same seed draws the same values, in bulk as one at a time
+    std::vector<BigInt> nums = {BigInt(-1)};
+    SplitMix64 bulk(9), single(9);
+    append_random_bits(nums, 5, 300, bulk);
+    append_random_below(nums, 5, bound, bulk);
+    CHECK(nums.size() == 11 and nums[0] == -1);
+    for (int i = 1; i <= 5; i++) CHECK(nums[i] == random_bits(300, single));
+    for (int i = 6; i <= 10; i++) CHECK(nums[i] == random_below(bound, single));
+}
+
+void test_gen_random() {
+    for (size_t digits : {1, 2, 19, 20, 100, 1000}) {
+        BigInt num = gen_random(digits);
+        CHECK(num.to_string().size() == digits);
+    }
+    BigInt num = gen_random();
+    CHECK(num > 0);
+}
+
+int main() {
+    test_engine();
+    test_random_bits();
+    test_random_below();
+    test_gen_random();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,106 @@
+/*
+    Arithmetic with long long operands, which works on the limbs directly:
+    the extreme values of the scalar, carries through long runs of limbs and
+    division by single limbs of every shape.
+*/
+
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+
+void test_add_sub() {
+    BigInt ones = pow(BigInt(2), 640) - 1;  // ten limbs of all ones
+    CHECK(ones + 1 == pow(BigInt(2), 640));
+    CHECK(pow(BigInt(2), 640) - 1 == ones);
+    CHECK(ones - -1 == pow(BigInt(2), 640));
+    CHECK((1 - pow(BigInt(2), 640)) == -ones);
+
+    CHECK_EQ((BigInt(LLONG_MAX) + LLONG_MAX).to_string(),
+             "18446744073709551614");
+    CHECK_EQ((BigInt(LLONG_MIN) + LLONG_MIN).to_string(),
+             "-18446744073709551616");
+    CHECK_EQ((BigInt(0) - LLONG_MIN).to_string(), "9223372036854775808");
+    CHECK_EQ((LLONG_MIN - BigInt(1)).to_string(), "-9223372036854775809");
+    CHECK_EQ((BigInt("18446744073709551616") + LLONG_MIN).to_string(),
+             "9223372036854775808");
+    CHECK_EQ((BigInt(5) + -7).to_string(), "-2");
+
+    BigInt num("-18446744073709551616");
+    num += 1;
+    CHECK_EQ(num.to_string(), "-18446744073709551615");
+    num -= LLONG_MIN;
+    CHECK_EQ(num.to_string(), "-9223372036854775807");
+    num += LLONG_MAX;
+    CHECK_EQ(num.to_string(), "0");
+
+    BigInt counter = pow(BigInt(2), 128) - 2;
+    ++counter;
+    counter++;
+    CHECK(counter == pow(BigInt(2), 128));
+    --counter;
+    CHECK(counter-- == pow(BigInt(2), 128) - 1);
+    CHECK(counter == pow(BigInt(2), 128) - 2);
+}
+
+void test_mul() {
+    CHECK_EQ((BigInt("18446744073709551615") * LLONG_MIN).to_string(),
+             "-170141183460469231722463931679029329920");
+    CHECK_EQ((LLONG_MIN * BigInt(LLONG_MIN)).to_string(),
+             "85070591730234615865843651857942052864");
+    CHECK_EQ((BigInt("-123456789012345678901234567890") * -1).to_string(),
+             "123456789012345678901234567890");
+    CHECK_EQ((BigInt("123456789012345678901234567890") * 0).to_string(), "0");
+
+    BigInt num = 1;
+    for (int i = 0; i < 40; i++) num *= 1000000007;
+    CHECK(num == pow(BigInt(1000000007), 40));
+}
+
+void test_div_mod() {
+    BigInt factorial = 1;
+    for (int i = 2; i <= 50; i++) factorial *= i;
+    for (int i = 50; i >= 2; i--) {
+        CHECK(factorial % i == 0);
+        factorial /= i;
+    }
+    CHECK(factorial == 1);
+
+    CHECK_EQ((BigInt("340282366920938463463374607431768211455") / LLONG_MIN)
+                 .to_string(),
+             "-36893488147419103231");
+    CHECK_EQ((BigInt("340282366920938463463374607431768211455") % LLONG_MIN)
+                 .to_string(),
+             "9223372036854775807");
+    CHECK_EQ((BigInt("-1000000000000000000000") / 7).to_string(),
+             "-142857142857142857142");
+    CHECK_EQ((BigInt("-1000000000000000000000") % 7).to_string(), "-6");
+    CHECK_THROWS(BigInt(5) / 0, std::logic_error);
+    CHECK_THROWS(BigInt(5) % 0, std::logic_error);
+
+    // every divisor normalisation, against division by the same BigInt
+    DigitSource source(14);
+    long long divisors[] = {1, 2, 3, 10, 1000000007, 4294967296,
+                            6148914691236517205, LLONG_MAX, -5, LLONG_MIN};
+    for (size_t length : {1, 19, 20, 100, 2000}) {
+        BigInt num(source.digits(length));
+        for (long long divisor : divisors) {
+            CHECK(num / divisor == num / BigInt(divisor));
+            CHECK(num % divisor == num % BigInt(divisor));
+            CHECK(-num % divisor == -(num % BigInt(divisor)));
+        }
+    }
+}
+
+int main() {
+    test_add_sub();
+    test_mul();
+    test_div_mod();
+
+    return numericxx::test::finish();
+}
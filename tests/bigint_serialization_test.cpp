@@ -0,0 +1,106 @@
+/*
+    Binary serialization: the exact bytes of small and limb encodings, round
+    trips through buffers, streams and views, and rejection of encodings that
+    are truncated, non-canonical or of another version.
+*/
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+using Bytes = std::vector<unsigned char>;
+
+// Encodes a BigInt into a buffer of serialized_size bytes
+Bytes encode(const BigInt& num) {
+    Bytes bytes(serialized_size(num));
+    CHECK(serialize(bytes.data(), num) == bytes.data() + bytes.size());
+    return bytes;
+}
+
+// Checks that decoding a byte string throws invalid_argument
+void check_rejected(const Bytes& bytes) {
+    BigInt num = 7;
+    CHECK_THROWS(deserialize(bytes.data(), bytes.data() + bytes.size(), num),
+                 std::invalid_argument);
+    CHECK(num == 7);
+}
+
+void test_known_encodings() {
+    CHECK(encode(0) == Bytes({0x10, 0x00}));
+    CHECK(encode(-1) == Bytes({0x11, 0x01}));
+    CHECK(encode(300) == Bytes({0x10, 0xac, 0x02}));
+    CHECK(encode(BigInt("18446744073709551615")) ==
+          Bytes({0x10, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                 0x01}));
+
+    // -(2^64 + 2): two limbs, least significant first
+    Bytes limbs = {0x13, 0x02, 2, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0};
+    CHECK(encode(-(pow(BigInt(2), 64) + 2)) == limbs);
+    BigIntView view;
+    CHECK(view.read(limbs.data(), limbs.data() + limbs.size()) ==
+          limbs.data() + limbs.size());
+    CHECK(view.size() == 2 and view.is_negative());
+    CHECK(view.limb(0) == 2 and view.limb(1) == 1);
+}
+
+void test_round_trips() {
+    DigitSource source(18);
+    std::vector<BigInt> values = {0, 1, -1, 127, 128, -16384};
+    for (size_t length : {10, 19, 20, 21, 100, 5000}) {
+        values.push_back(BigInt(source.digits(length)));
+        values.push_back(-BigInt(source.nines(length)));
+    }
+
+    // a block of consecutive values, written to a buffer and to a stream
+    Bytes block;
+    std::ostringstream stream;
+    for (const BigInt& num : values) {
+        Bytes bytes = encode(num);
+        block.insert(block.end(), bytes.begin(), bytes.end());
+        serialize(stream, num);
+    }
+    std::string streamed = stream.str();
+    CHECK(Bytes(streamed.begin(), streamed.end()) == block);
+
+    // read back from a copy one byte off alignment, as BigInts and as views
+    Bytes unaligned(block.size() + 1);
+    std::copy(block.begin(), block.end(), unaligned.begin() + 1);
+    BigIntReader reader(unaligned.data() + 1, block.size());
+    BigIntReader view_reader(unaligned.data() + 1, block.size());
+    for (const BigInt& num : values) {
+        CHECK(reader.read() == num);
+        CHECK(view_reader.read_view().to_bigint() == num);
+    }
+    CHECK(reader.at_end() and view_reader.remaining() == 0);
+}
+
+void test_invalid_encodings() {
+    check_rejected({});
+    check_rejected({0x10});                    // no magnitude
+    check_rejected({0x20, 0x01});              // another version
+    check_rejected({0x14, 0x01});              // unknown flag
+    check_rejected({0x11, 0x00});              // negative zero
+    check_rejected({0x10, 0x81, 0x00});        // varint with a zero tail
+    check_rejected({0x10, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                    0xff, 0x02});              // more than 64 bits
+    check_rejected({0x12, 0x01, 5, 0, 0, 0, 0, 0, 0, 0});  // one limb
+    check_rejected({0x12, 0x02, 5, 0, 0, 0, 0, 0, 0, 0,
+                    0, 0, 0, 0, 0, 0, 0, 0});  // zero top limb
+    check_rejected({0x12, 0x02, 5, 0, 0, 0, 0, 0, 0, 0, 1});  // truncated
+    check_rejected({0x12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                    0xff, 0x01});              // limb count past the end
+}
+
+int main() {
+    test_known_encodings();
+    test_round_trips();
+    test_invalid_encodings();
+
+    return numericxx::test::finish();
+}
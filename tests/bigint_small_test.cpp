@@ -0,0 +1,96 @@
+/*
+    Values held in the inline limbs and the i128 fast path, at the
+    boundaries where the operators fall back to the limb kernels.
+*/
+
+#include <string>
+#include <utility>
+
+#include "check.hpp"
+#include "utils/BigInt.hpp"
+
+const std::string I128_MAX_STRING = "170141183460469231731687303715884105727";
+const std::string I128_MIN_STRING = "-170141183460469231731687303715884105728";
+const std::string U128_MAX_STRING = "340282366920938463463374607431768211455";
+
+void test_i128_boundaries() {
+    BigInt max(I128_MAX_STRING);
+    BigInt min(I128_MIN_STRING);
+
+    CHECK_EQ((max + 1).to_string(), "170141183460469231731687303715884105728");
+    CHECK_EQ((min - 1).to_string(), "-170141183460469231731687303715884105729");
+    CHECK_EQ((max + max).to_string(),
+             "340282366920938463463374607431768211454");
+    CHECK_EQ((min + min).to_string(),
+             "-340282366920938463463374607431768211456");
+    CHECK_EQ((max - min).to_string(), U128_MAX_STRING);
+    CHECK_EQ((min - max).to_string(), "-" + U128_MAX_STRING);
+    CHECK_EQ((max + min).to_string(), "-1");
+    CHECK_EQ((-min).to_string(), "170141183460469231731687303715884105728");
+
+    CHECK_EQ((max * 2).to_string(), "340282366920938463463374607431768211454");
+    CHECK_EQ((min * -1).to_string(), "170141183460469231731687303715884105728");
+    CHECK_EQ((max * max).to_string(),
+             "289480223093290488558927462521719769629772137994892025464010213"
+             "94546514198529");
+    CHECK_EQ((BigInt("9223372036854775808") * BigInt("-9223372036854775808"))
+                 .to_string(),
+             "-85070591730234615865843651857942052864");
+
+    // min / -1 overflows i128 and goes through the limb kernels
+    CHECK_EQ((min / -1).to_string(), "170141183460469231731687303715884105728");
+    CHECK_EQ((min % -1).to_string(), "0");
+    CHECK_EQ((min / max).to_string(), "-1");
+    CHECK_EQ((min % max).to_string(), "-1");
+    CHECK_EQ((max / 1000000007).to_string(), "170141182269480955845320612798");
+    CHECK_EQ((max % 1000000007).to_string(), "639816141");
+
+    BigInt num = max;
+    num += 1;
+    CHECK_EQ(num.to_string(), "170141183460469231731687303715884105728");
+    num -= 1;
+    CHECK(num == max);
+    num = min;
+    num -= 1;
+    CHECK_EQ(num.to_string(), "-170141183460469231731687303715884105729");
+    num += 1;
+    CHECK(num == min);
+}
+
+void test_inline_limbs() {
+    // values around the two-limb inline capacity
+    BigInt max(U128_MAX_STRING);
+    BigInt grown = max + 1;
+    CHECK_EQ(grown.to_string(), "340282366920938463463374607431768211456");
+    CHECK_EQ((grown - 1).to_string(), U128_MAX_STRING);
+
+    // copies and moves across inline and heap storage
+    BigInt small(12345);
+    BigInt large = pow(BigInt(3), 200);
+    BigInt copy = large;
+    copy = small;
+    CHECK_EQ(copy.to_string(), "12345");
+    copy = large;
+    CHECK(copy == large);
+    std::swap(small, large);
+    CHECK_EQ(large.to_string(), "12345");
+    CHECK(small == copy);
+    small = std::move(large);
+    CHECK_EQ(small.to_string(), "12345");
+
+    // quotient and remainder assigned together
+    BigInt quotient, remainder;
+    BigInt dividend = pow(BigInt(10), 40) + 7;
+    quotient = dividend / BigInt("100000000000000000000");
+    remainder = dividend % BigInt("100000000000000000000");
+    CHECK_EQ(quotient.to_string(), "100000000000000000000");
+    CHECK_EQ(remainder.to_string(), "7");
+    CHECK_EQ(big_pow10(40).to_string(), "1" + std::string(40, '0'));
+}
+
+int main() {
+    test_i128_boundaries();
+    test_inline_limbs();
+
+    return numericxx::test::finish();
+}
@@ -0,0 +1,91 @@
+/*
+    Squaring at every tier, with the thresholds lowered, and the pow and
+    sqrt functions built on it.
+*/
+
+#define NUMERICXX_BIGINT_KARATSUBA_THRESHOLD 4
+#define NUMERICXX_BIGINT_TOOM3_THRESHOLD 8
+#define NUMERICXX_BIGINT_TOOM4_THRESHOLD 16
+#define NUMERICXX_BIGINT_NTT_THRESHOLD 64
+
+#include <stdexcept>
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+using numericxx::test::multiply_decimal;
+
+void test_square() {
+    CHECK_EQ(square(BigInt(0)).to_string(), "0");
+    CHECK_EQ(square(BigInt(-3)).to_string(), "9");
+    CHECK_EQ(square(BigInt("-18446744073709551616")).to_string(),
+             "340282366920938463463374607431768211456");
+
+    // from one limb up to NTT sizes, against the reference product
+    DigitSource source(8);
+    for (size_t length : {19, 40, 80, 150, 300, 600, 1300, 2600}) {
+        for (std::string num : {source.digits(length), source.nines(length)}) {
+            std::string product = multiply_decimal(num, num);
+            BigInt value(num);
+            CHECK_EQ(square(value).to_string(), product);
+            CHECK_EQ(square(-value).to_string(), product);
+            CHECK_EQ((value * value).to_string(), product);
+        }
+    }
+
+    // all-ones limbs, whose square carries through every limb
+    for (size_t limbs : {1, 5, 17, 40, 100}) {
+        BigInt ones = pow(BigInt(2), 64 * limbs) - 1;
+        CHECK(square(ones) == ones * (ones + 1) - ones);
+    }
+}
+
+void test_pow() {
+    CHECK_THROWS(pow(BigInt(0), 0), std::logic_error);
+    CHECK_EQ(pow(BigInt(0), 5).to_string(), "0");
+    CHECK_EQ(pow(BigInt(-2), 63).to_string(), "-9223372036854775808");
+    CHECK_EQ(pow(BigInt(-2), 64).to_string(), "18446744073709551616");
+    CHECK_EQ(pow(7, 50).to_string(),
+             "1798465042647412146620280340569649349251249");
+    CHECK_EQ(pow(std::string("10"), 30).to_string(),
+             "1" + std::string(30, '0'));
+
+    // (3^a)^b == 3^(a * b) and 3^a * 3^b == 3^(a + b)
+    BigInt three = 3;
+    CHECK(pow(pow(three, 123), 45) == pow(three, 123 * 45));
+    CHECK(pow(three, 2000) * pow(three, 3001) == pow(three, 5001));
+}
+
+void test_sqrt() {
+    CHECK_EQ(sqrt(BigInt(63)).to_string(), "7");
+    CHECK_EQ(sqrt(BigInt(64)).to_string(), "8");
+    CHECK_EQ(sqrt(BigInt(65)).to_string(), "8");
+    CHECK_EQ(sqrt(BigInt(1)).to_string(), "1");
+    CHECK_EQ(sqrt(BigInt(3)).to_string(), "1");
+    for (long long n = 0; n < 2000; n++) {
+        BigInt root = sqrt(BigInt(n));
+        CHECK(root * root <= n and (root + 1) * (root + 1) > n);
+    }
+
+    // the integer square root of n^2 - 1, n^2 and n^2 + 1
+    DigitSource source(9);
+    for (size_t length : {10, 30, 100, 400}) {
+        BigInt num(source.digits(length));
+        BigInt num_squared = square(num);
+        CHECK(sqrt(num_squared) == num);
+        CHECK(sqrt(num_squared - 1) == num - 1);
+        CHECK(sqrt(num_squared + 1) == num);
+        CHECK(sqrt(num_squared + 2 * num) == num);
+    }
+}
+
+int main() {
+    test_square();
+    test_pow();
+    test_sqrt();
+
+    return numericxx::test::finish();
+}
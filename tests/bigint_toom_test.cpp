@@ -0,0 +1,73 @@
+/*
+    Karatsuba and Toom-Cook multiplication, with the thresholds lowered so
+    that small operands recurse through every tier, checked against the
+    reference product.
+*/
+
+#define NUMERICXX_BIGINT_KARATSUBA_THRESHOLD 4
+#define NUMERICXX_BIGINT_TOOM3_THRESHOLD 8
+#define NUMERICXX_BIGINT_TOOM4_THRESHOLD 16
+
+#include <string>
+
+#include "check.hpp"
+#include "reference.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::test::DigitSource;
+using numericxx::test::multiply_decimal;
+
+// Checks the product of two decimal operands, and of their negations
+void check_product(const std::string& num1, const std::string& num2) {
+    std::string product = multiply_decimal(num1, num2);
+    CHECK_EQ((BigInt(num1) * BigInt(num2)).to_string(), product);
+    CHECK(-BigInt(num1) * BigInt(num2) == -BigInt(product));
+}
+
+void test_balanced() {
+    // 19 digits is a little over one limb, so these cover every tier and
+    // the uneven top pieces of each split
+    DigitSource source(5);
+    for (size_t length : {80, 150, 160, 300, 310, 600, 1200, 2500}) {
+        check_product(source.digits(length), source.digits(length));
+        check_product(source.nines(length), source.nines(length));
+        check_product(source.digits(length), source.nines(length - 30));
+    }
+}
+
+void test_unbalanced() {
+    DigitSource source(6);
+    for (size_t length1 : {300, 700, 2000})
+        for (size_t length2 : {80, 170, 400, 1000}) {
+            if (length2 > length1) continue;
+            check_product(source.digits(length1), source.nines(length2));
+        }
+}
+
+void test_special_operands() {
+    // all-ones limbs maximise every evaluation and intermediate value
+    BigInt ones = pow(BigInt(2), 64 * 100) - 1;
+    CHECK(ones * ones ==
+          pow(BigInt(2), 64 * 200) - pow(BigInt(2), 64 * 100 + 1) + 1);
+
+    // pieces of zeros, which make some of the evaluations zero
+    BigInt sparse = pow(BigInt(2), 64 * 90) + pow(BigInt(2), 64 * 30);
+    CHECK(sparse * sparse == pow(BigInt(2), 64 * 180) +
+                                 pow(BigInt(2), 64 * 120 + 1) +
+                                 pow(BigInt(2), 64 * 60));
+    BigInt high = pow(BigInt(2), 64 * 95);
+    CHECK(high * (high - 1) == pow(BigInt(2), 64 * 190) - high);
+
+    // (10^n - 1)^2 = 10^2n - 2 * 10^n + 1
+    std::string nines(2000, '9');
+    CHECK_EQ((BigInt(nines) * BigInt(nines)).to_string(),
+             std::string(1999, '9') + "8" + std::string(1999, '0') + "1");
+}
+
+int main() {
+    test_balanced();
+    test_unbalanced();
+    test_special_operands();
+
+    return numericxx::test::finish();
+}
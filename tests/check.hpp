@@ -0,0 +1,66 @@
+/*
+    Minimal checks for the numericxx tests. Each test is a standalone program
+    that runs its checks in order, reports every one that fails with its
+    location and exits with a non-zero status if any did, so that ctest can
+    run it directly.
+*/
+
+#ifndef NUMERICXX_TESTS_CHECK_HPP_
+#define NUMERICXX_TESTS_CHECK_HPP_
+
+#include <cstdlib>
+#include <iostream>
+
+namespace numericxx::test {
+
+inline int failures = 0;
+
+inline void check(bool passed, const char* expression, const char* file,
+                  int line) {
+    if (passed) return;
+
+    failures++;
+    std::cerr << file << ":" << line << ": CHECK(" << expression
+              << ") failed\n";
+}
+
+template <class Actual, class Expected>
+void check_equal(const Actual& actual, const Expected& expected,
+                 const char* expression, const char* file, int line) {
+    if (actual == expected) return;
+
+    failures++;
+    std::cerr << file << ":" << line << ": CHECK_EQ(" << expression
+              << ") failed\n    actual:   " << actual
+              << "\n    expected: " << expected << "\n";
+}
+
+inline int finish() {
+    if (failures) std::cerr << failures << " check(s) failed\n";
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+}  // namespace numericxx::test
+
+#define CHECK(expression) \
+    numericxx::test::check((expression), #expression, __FILE__, __LINE__)
+
+#define CHECK_EQ(actual, expected)                                     \
+    numericxx::test::check_equal((actual), (expected),                 \
+                                 #actual " == " #expected, __FILE__, \
+                                 __LINE__)
+
+// Checks that evaluating `expression` throws `exception`
+#define CHECK_THROWS(expression, exception)                            \
+    do {                                                               \
+        bool thrown = false;                                           \
+        try {                                                          \
+            (void)(expression);                                        \
+        } catch (const exception&) {                                   \
+            thrown = true;                                             \
+        }                                                              \
+        numericxx::test::check(thrown, #expression " throws " #exception, \
+                               __FILE__, __LINE__);                    \
+    } while (false)
+
+#endif  // check.hpp
@@ -0,0 +1,93 @@
+/*
+    ModInt<P> for moduli on either side of 2^32: conversions of negative and
+    extreme integers, the field operations against BigInt remainders, powers,
+    inverses and primitive roots, at run time and at compile time.
+*/
+
+#include <climits>
+#include <tuple>
+#include <type_traits>
+
+#include "check.hpp"
+#include "numericxx/modint.hpp"
+#include "utils/BigInt.hpp"
+
+using numericxx::ModInt;
+using numericxx::SplitMix64;
+using numericxx::u32;
+using numericxx::u64;
+
+using NttMod = ModInt<998244353>;
+using WideMod = ModInt<4294967311>;           // just above 2^32
+using MersenneMod = ModInt<2305843009213693951>;  // 2^61 - 1
+
+static_assert(sizeof(NttMod) == sizeof(u32) and sizeof(WideMod) == sizeof(u64));
+static_assert(std::is_same_v<NttMod::value_type, u32>);
+static_assert(std::is_trivially_copyable_v<MersenneMod>);
+static_assert((NttMod(2) / 3 * 3).value() == 2);
+static_assert(NttMod::primitive_root() == 3);
+static_assert(NttMod(3).pow(998244352) == NttMod(1));
+
+// Checks the field operations on random residues against BigInt remainders
+template <class Mod>
+void check_operations(SplitMix64& engine) {
+    BigInt modulus((long long)Mod::modulus());
+    for (int i = 0; i < 500; i++) {
+        long long a = engine(), b = engine();
+        Mod x(a), y(b);
+        BigInt big_x = std::get<1>(divmod_floor(BigInt(a), modulus));
+        BigInt big_y = std::get<1>(divmod_floor(BigInt(b), modulus));
+        CHECK(BigInt((long long)x.value()) == big_x);
+        CHECK(BigInt((long long)(x * y).value()) == big_x * big_y % modulus);
+        CHECK(BigInt((long long)(x + y).value()) == (big_x + big_y) % modulus);
+        CHECK(BigInt((long long)(x - y).value()) ==
+              std::get<1>(divmod_floor(big_x - big_y, modulus)));
+        CHECK(-x + x == Mod(0));
+        if (y != Mod(0)) CHECK(x / y * y == x and y * y.inverse() == Mod(1));
+    }
+}
+
+void test_conversions() {
+    CHECK(NttMod(-1).value() == 998244352);
+    CHECK(NttMod(998244353).value() == 0);
+    CHECK(NttMod(-998244353LL * 5 - 2).value() == 998244351);
+    CHECK(NttMod(ULLONG_MAX).value() == ULLONG_MAX % 998244353);
+    CHECK(MersenneMod(LLONG_MIN).value() == 2305843009213693947);
+    CHECK(MersenneMod(LLONG_MAX).value() == LLONG_MAX % 2305843009213693951);
+    CHECK(WideMod(u32(4294967295)).value() == 4294967295);
+    CHECK(NttMod().value() == 0 and NttMod::modulus() == 998244353);
+}
+
+void test_operations() {
+    SplitMix64 engine(27);
+    check_operations<NttMod>(engine);
+    check_operations<ModInt<1000000007>>(engine);
+    check_operations<ModInt<4294967291>>(engine);  // just below 2^32
+    check_operations<WideMod>(engine);
+    check_operations<MersenneMod>(engine);
+
+    MersenneMod num = 1;
+    num += MersenneMod(-1);
+    num -= 5;
+    num *= 3;
+    num /= 3;
+    CHECK(num == MersenneMod(-5) and +num == num);
+    CHECK(MersenneMod(123456789).pow(1000000000000000000).value() ==
+          2210905249442851473);
+    CHECK(MersenneMod(0).inverse() == MersenneMod(0));
+}
+
+void test_primitive_roots() {
+    CHECK(ModInt<1000000007>::primitive_root() == 5);
+    CHECK(ModInt<4294967291>::primitive_root() == 2);
+    CHECK(WideMod::primitive_root() == 3);
+    CHECK(MersenneMod::primitive_root() == 37);
+}
+
+int main() {
+    test_conversions();
+    test_operations();
+    test_primitive_roots();
+
+    return numericxx::test::finish();
+}
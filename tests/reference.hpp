@@ -0,0 +1,101 @@
+/*
+    Reference arithmetic for the numericxx tests, independent of BigInt:
+    deterministic decimal operands and a schoolbook product of decimal
+    strings in base 10^9, against which the faster multiplication algorithms
+    are checked.
+*/
+
+#ifndef NUMERICXX_TESTS_REFERENCE_HPP_
+#define NUMERICXX_TESTS_REFERENCE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "numericxx/types.hpp"
+
+namespace numericxx::test {
+
+/*
+    DigitSource
+    -----------
+    Produces decimal numbers of a given length from a SplitMix64 sequence, so
+    that every run of a test sees the same operands.
+*/
+
+class DigitSource {
+    u64 state;
+
+    u64 next() {
+        u64 z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+   public:
+    explicit DigitSource(u64 seed) : state(seed) {}
+
+    // A number of exactly `length` digits, without leading zeros
+    std::string digits(size_t length) {
+        std::string num(length, '0');
+        for (size_t i = 0; i < length; i++)
+            num[i] = char('0' + next() % 10);
+        if (length > 0 and num[0] == '0') num[0] = char('1' + next() % 9);
+        return num;
+    }
+
+    // A number of `length` digits, most of them nines or zeros, to exercise
+    // carries and borrows
+    std::string nines(size_t length) {
+        std::string num(length, '9');
+        for (size_t i = 1; i < length; i++)
+            if (next() % 8 == 0) num[i] = char('0' + next() % 10);
+        return num;
+    }
+};
+
+/*
+    multiply_decimal
+    ----------------
+    Returns the product of two non-negative decimal strings.
+*/
+
+inline std::string multiply_decimal(const std::string& num1,
+                                    const std::string& num2) {
+    constexpr u64 BASE = 1000000000;
+
+    auto to_chunks = [](const std::string& num) {
+        std::vector<u64> chunks;
+        for (size_t end = num.size(); end > 0;) {
+            size_t start = end > 9 ? end - 9 : 0;
+            chunks.push_back(std::stoull(num.substr(start, end - start)));
+            end = start;
+        }
+        return chunks;
+    };
+
+    std::vector<u64> chunks1 = to_chunks(num1), chunks2 = to_chunks(num2);
+    std::vector<u64> product(chunks1.size() + chunks2.size());
+    for (size_t i = 0; i < chunks1.size(); i++) {
+        u64 carry = 0;
+        for (size_t j = 0; j < chunks2.size(); j++) {
+            u64 column = product[i + j] + chunks1[i] * chunks2[j] + carry;
+            product[i + j] = column % BASE;
+            carry = column / BASE;
+        }
+        product[i + chunks2.size()] += carry;
+    }
+    while (product.size() > 1 and product.back() == 0) product.pop_back();
+
+    std::string result = std::to_string(product.back());
+    for (size_t i = product.size() - 1; i-- > 0;) {
+        std::string chunk = std::to_string(product[i]);
+        result += std::string(9 - chunk.size(), '0') + chunk;
+    }
+
+    return result;
+}
+
+}  // namespace numericxx::test
+
+#endif  // reference.hpp